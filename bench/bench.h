@@ -0,0 +1,77 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// The checks of the benchmarks are asserts, they must run in release builds as well
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "allocators.h"
+
+/**
+ * Monotonic time in seconds, for timing the benchmarks.
+ */
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Keeps the compiler from optimizing away a value only computed for a benchmark.
+ */
+static inline void bench_keep(void* ptr) {
+    __asm__ volatile("" : : "r"(ptr) : "memory");
+}
+
+/**
+ * Xorshift pseudo-random generator, deterministic so the runs of a benchmark are comparable.
+ */
+static inline uint64_t bench_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * Shuffles `count` pointers in place (Fisher-Yates).
+ */
+static inline void bench_shuffle(void** ptrs, size_t count, uint64_t* state) {
+    for (size_t i = count; i > 1; i -= 1) {
+        size_t j   = (size_t) (bench_random(state) % i);
+        void*  tmp = ptrs[i - 1];
+        ptrs[i - 1] = ptrs[j];
+        ptrs[j]     = tmp;
+    }
+}
+
+#ifndef BENCH_MAX_THREADS
+#define BENCH_MAX_THREADS 8
+#endif
+
+typedef void (*Bench_Thread_Fn)(size_t thread_index, void* user_data);
+
+/**
+ * Runs `fn` on `thread_count` threads (at most `BENCH_MAX_THREADS`), released together once they 
+ * are all started. Returns the time from the release to the last join, in seconds.
+ */
+double bench_run_threads(size_t thread_count, Bench_Thread_Fn fn, void* user_data);
+
+void bench_linear_virtual(void);
+void bench_zeroing(void);
+void bench_linear_atomic(void);
+void bench_pool_bitmap(void);
+void bench_pool_concurrent(void);
+void bench_pool_batch(void);
+void bench_pool_slot_map(void);
+void bench_pool_sort(void);
+void bench_pool_align(void);
+void bench_pool_coloring(void);
+void bench_buddy(void);
+void bench_tlsf(void);
+void bench_slab(void);
+
+#endif
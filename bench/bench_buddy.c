@@ -0,0 +1,160 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define BUDDY_BUF_LEN   (16 * 1024 * 1024)
+#define BUDDY_SLOTS     2560
+#define BUDDY_STEPS     (1 << 17)
+#define BUDDY_MAX_SIZE  (16 * 1024)
+
+typedef struct Buddy_Slot {
+    void*  ptr;
+    size_t size;
+} Buddy_Slot;
+
+typedef struct Buddy_Result {
+    double time;          // Seconds for the whole run
+    size_t failures;      // Requests which did not fit
+    double peak_live;     // Largest live bytes requested, relative to the buffer
+    double internal;      // Bytes of the live blocks past the requested sizes at the end, relative to the live bytes
+    size_t largest_free;  // Largest request which still fits at the end, in bytes
+} Buddy_Result;
+
+/**
+ * Page-granular sizes with a long tail, like the buffers of a cache: mostly a few pages, sometimes 
+ * many, never a power of two on purpose.
+ */
+static size_t buddy_random_size(uint64_t* seed) {
+    uint64_t r     = bench_random(seed);
+    size_t   pages = (r & 7) == 0 ? 1 + (size_t) ((r >> 3) % 3) : 1;
+    return pages * ((size_t) ((r >> 8) % BUDDY_MAX_SIZE) + 1) / 2 + 64;
+}
+
+static void* buddy_alloc(void* allocator, bool buddy, size_t size) {
+    return buddy ? allocator_buddy_alloc(allocator, size) : allocator_free_list_alloc(allocator, size);
+}
+
+static void buddy_free(void* allocator, bool buddy, void* ptr) {
+    if (buddy) {
+        allocator_buddy_free(allocator, ptr);
+    } else {
+        allocator_free_list_free(allocator, ptr);
+    }
+}
+
+/**
+ * Replaces random slots with new allocations of random sizes, then probes the largest request 
+ * still fitting. The same seed gives both allocators the same sequence of requests.
+ */
+static Buddy_Result buddy_run(void* allocator, bool buddy, size_t usable_len) {
+    static Buddy_Slot slots[BUDDY_SLOTS];
+    memset(slots, 0, sizeof(slots));
+
+    uint64_t     seed   = 0x853c49e6748fea9b;
+    Buddy_Result result = { 0.0, 0, 0.0, 0.0, 0 };
+    size_t       live   = 0;
+
+    double start = bench_now();
+    for (size_t step = 0; step < BUDDY_STEPS; step += 1) {
+        Buddy_Slot* slot = &slots[bench_random(&seed) % BUDDY_SLOTS];
+        if (slot->ptr != NULL) {
+            buddy_free(allocator, buddy, slot->ptr);
+            live -= slot->size;
+        }
+
+        slot->size = buddy_random_size(&seed);
+        slot->ptr  = buddy_alloc(allocator, buddy, slot->size);
+        if (slot->ptr == NULL) {
+            result.failures += 1;
+            slot->size = 0;
+            continue;
+        }
+        memset(slot->ptr, 0xab, slot->size < 64 ? slot->size : 64);
+        live += slot->size;
+
+        double live_ratio = (double) live / (double) usable_len;
+        if (live_ratio > result.peak_live) {
+            result.peak_live = live_ratio;
+        }
+    }
+    result.time = bench_now() - start;
+
+    // Internal fragmentation: a buddy block is the size rounded up to a power of two, a free list block
+    // adds its header, the rounding to the default alignment and a remainder too small to split off
+    size_t overhead = 0;
+    for (size_t i = 0; i < BUDDY_SLOTS; i += 1) {
+        if (slots[i].ptr == NULL) {
+            continue;
+        }
+
+        size_t block;
+        if (buddy) {
+            block = ((Allocator_Buddy*) allocator)->min_block_size;
+            while (block < slots[i].size) {
+                block *= 2;
+            }
+        } else {
+            // The two low bits of the size are flags
+            block = (((Allocator_Free_List_Header*) slots[i].ptr) - 1)->size & ~(size_t) 3;
+        }
+        overhead += block - slots[i].size;
+    }
+    result.internal = live > 0 ? (double) overhead / (double) live : 0.0;
+
+    // External fragmentation: the largest power of two request still served
+    size_t size = 64;
+    while (size * 2 <= usable_len) {
+        size *= 2;
+    }
+    for (; size >= 64; size /= 2) {
+        void* probe = buddy_alloc(allocator, buddy, size);
+        if (probe != NULL) {
+            buddy_free(allocator, buddy, probe);
+            result.largest_free = size;
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < BUDDY_SLOTS; i += 1) {
+        buddy_free(allocator, buddy, slots[i].ptr);
+    }
+    return result;
+}
+
+static void buddy_print(const char* name, Buddy_Result result) {
+    printf("%-20s %7.1f ns/op  %6zu failures  peak live %5.1f%%  overhead %5.1f%%  largest free %6zu KiB\n",
+        name, result.time / BUDDY_STEPS * 1e9, result.failures, result.peak_live * 100.0, result.internal * 100.0, result.largest_free / 1024);
+}
+
+void bench_buddy(void) {
+    void* buf = malloc(BUDDY_BUF_LEN);
+    assert(buf != NULL);
+
+    printf("%d steps replacing one of %d live buffers of up to %d KiB, in a %d MiB buffer\n\n", BUDDY_STEPS, BUDDY_SLOTS, 3 * BUDDY_MAX_SIZE / 2 / 1024, BUDDY_BUF_LEN >> 20);
+
+    Allocator_Buddy buddy;
+    allocator_buddy_init(&buddy, buf, BUDDY_BUF_LEN, 64);
+    Buddy_Result buddy_result = buddy_run(&buddy, true, buddy.buf_len);
+
+    // Every block went back and merged: the whole buffer is a single block again
+    size_t top = buddy.min_block_size << (buddy.order_count - 1);
+    void*  all = allocator_buddy_alloc(&buddy, top);
+    assert(all == buddy.buf);
+    allocator_buddy_free(&buddy, all);
+
+    Allocator_Free_List first_fit;
+    allocator_free_list_init(&first_fit, buf, BUDDY_BUF_LEN);
+    Buddy_Result first_fit_result = buddy_run(&first_fit, false, first_fit.buf_len);
+
+    Allocator_Free_List best_fit;
+    allocator_free_list_init(&best_fit, buf, BUDDY_BUF_LEN);
+    allocator_free_list_set_policy(&best_fit, ALLOCATOR_FREE_LIST_BEST_FIT);
+    Buddy_Result best_fit_result = buddy_run(&best_fit, false, best_fit.buf_len);
+
+    buddy_print("Allocator_Buddy", buddy_result);
+    buddy_print("free list first fit", first_fit_result);
+    buddy_print("free list best fit", best_fit_result);
+
+    free(buf);
+}
@@ -0,0 +1,112 @@
+#include <pthread.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define LINEAR_ATOMIC_ALLOC_SIZE   32
+#define LINEAR_ATOMIC_ALLOC_COUNT  (1 << 18) // Per thread
+#define LINEAR_ATOMIC_BUF_LEN      (BENCH_MAX_THREADS * LINEAR_ATOMIC_ALLOC_COUNT * LINEAR_ATOMIC_ALLOC_SIZE)
+
+typedef struct Linear_Atomic_Tag {
+    uint32_t thread_index;
+    uint32_t alloc_index;
+} Linear_Atomic_Tag;
+
+typedef struct Linear_Mutex {
+    Allocator_Linear linear;
+    pthread_mutex_t  lock;
+} Linear_Mutex;
+
+static void linear_atomic_worker(size_t thread_index, void* user_data) {
+    Allocator_Linear_Atomic* arena = (Allocator_Linear_Atomic*) user_data;
+
+    for (uint32_t i = 0; i < LINEAR_ATOMIC_ALLOC_COUNT; i += 1) {
+        Linear_Atomic_Tag* tag = allocator_linear_atomic_alloc_no_zero(arena, LINEAR_ATOMIC_ALLOC_SIZE);
+        assert(tag != NULL);
+        *tag = (Linear_Atomic_Tag) { (uint32_t) thread_index, i };
+    }
+}
+
+static void linear_mutex_worker(size_t thread_index, void* user_data) {
+    Linear_Mutex* arena = (Linear_Mutex*) user_data;
+
+    for (uint32_t i = 0; i < LINEAR_ATOMIC_ALLOC_COUNT; i += 1) {
+        pthread_mutex_lock(&arena->lock);
+        Linear_Atomic_Tag* tag = allocator_linear_alloc_no_zero(&arena->linear, LINEAR_ATOMIC_ALLOC_SIZE);
+        pthread_mutex_unlock(&arena->lock);
+        assert(tag != NULL);
+        *tag = (Linear_Atomic_Tag) { (uint32_t) thread_index, i };
+    }
+}
+
+/**
+ * The allocations are contiguous: walking the buffer must find every allocation of every thread 
+ * exactly once, in increasing order for each thread, so no two threads were handed the same bytes.
+ */
+static void linear_atomic_check(const uint8_t* buf, size_t thread_count) {
+    uint32_t next[BENCH_MAX_THREADS] = { 0 };
+
+    for (size_t offset = 0; offset < thread_count * LINEAR_ATOMIC_ALLOC_COUNT * LINEAR_ATOMIC_ALLOC_SIZE; offset += LINEAR_ATOMIC_ALLOC_SIZE) {
+        const Linear_Atomic_Tag* tag = (const Linear_Atomic_Tag*) &buf[offset];
+        assert(tag->thread_index < thread_count);
+        assert(tag->alloc_index == next[tag->thread_index]);
+        next[tag->thread_index] += 1;
+    }
+}
+
+static size_t linear_atomic_overflow_success[BENCH_MAX_THREADS];
+
+static void linear_atomic_overflow_worker(size_t thread_index, void* user_data) {
+    Allocator_Linear_Atomic* arena = (Allocator_Linear_Atomic*) user_data;
+
+    // Odd sizes and alignments, until the buffer runs out
+    for (size_t i = 1; ; i += 1) {
+        size_t   align = (size_t) 8 << (i % 4);
+        uint8_t* ptr   = allocator_linear_atomic_alloc_align(arena, i % 200 + 1, align);
+        if (ptr == NULL) {
+            break;
+        }
+        assert(((uintptr_t) ptr & (align - 1)) == 0);
+        assert(ptr + i % 200 + 1 <= arena->buf + arena->buf_len);
+        linear_atomic_overflow_success[thread_index] += i % 200 + 1;
+    }
+}
+
+void bench_linear_atomic(void) {
+    uint8_t* buf = ALLOCATOR_BACKING_MMAP.alloc(NULL, LINEAR_ATOMIC_BUF_LEN, 0);
+    assert(buf != NULL);
+
+    printf("%d allocations of %d bytes per thread, allocations per second\n\n", LINEAR_ATOMIC_ALLOC_COUNT, LINEAR_ATOMIC_ALLOC_SIZE);
+    printf("threads  Allocator_Linear_Atomic  mutex + Allocator_Linear\n");
+
+    for (size_t thread_count = 1; thread_count <= BENCH_MAX_THREADS; thread_count *= 2) {
+        Allocator_Linear_Atomic atomic_arena;
+        allocator_linear_atomic_init(&atomic_arena, buf, LINEAR_ATOMIC_BUF_LEN);
+        double atomic_time = bench_run_threads(thread_count, linear_atomic_worker, &atomic_arena);
+        linear_atomic_check(buf, thread_count);
+
+        Linear_Mutex mutex_arena;
+        allocator_linear_init(&mutex_arena.linear, buf, LINEAR_ATOMIC_BUF_LEN);
+        pthread_mutex_init(&mutex_arena.lock, NULL);
+        double mutex_time = bench_run_threads(thread_count, linear_mutex_worker, &mutex_arena);
+        pthread_mutex_destroy(&mutex_arena.lock);
+        linear_atomic_check(buf, thread_count);
+
+        double total = (double) (thread_count * LINEAR_ATOMIC_ALLOC_COUNT);
+        printf("%7zu  %20.1f M/s  %21.1f M/s\n", thread_count, total / atomic_time * 1e-6, total / mutex_time * 1e-6);
+    }
+
+    // Racing for the end of a small buffer fails cleanly: nothing is handed out past the end
+    Allocator_Linear_Atomic small_arena;
+    allocator_linear_atomic_init(&small_arena, buf, 64 * 1024);
+    bench_run_threads(BENCH_MAX_THREADS, linear_atomic_overflow_worker, &small_arena);
+
+    size_t success = 0;
+    for (size_t i = 0; i < BENCH_MAX_THREADS; i += 1) {
+        success += linear_atomic_overflow_success[i];
+    }
+    assert(success <= small_arena.buf_len);
+    printf("\noverflow: %zu of %zu bytes handed out before every thread failed\n", success, small_arena.buf_len);
+
+    ALLOCATOR_BACKING_MMAP.free(NULL, buf, LINEAR_ATOMIC_BUF_LEN);
+}
@@ -0,0 +1,60 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define LINEAR_VIRTUAL_RESERVE    ((size_t) 1 << 30)
+#define LINEAR_VIRTUAL_GRANULE    (64 * 1024)
+#define LINEAR_VIRTUAL_FRAME_LEN  (16 * 1024 * 1024)
+#define LINEAR_VIRTUAL_ALLOC_SIZE (64 * 1024)
+#define LINEAR_VIRTUAL_FRAMES     32
+
+/**
+ * Fills a frame of the arena with allocations which are written right away, then resets the arena
+ * keeping `keep_committed` bytes committed. Returns the time per frame, in milliseconds.
+ */
+static double linear_virtual_run(Allocator_Linear_Virtual* arena, size_t keep_committed) {
+    double start = bench_now();
+
+    for (size_t frame = 0; frame < LINEAR_VIRTUAL_FRAMES; frame += 1) {
+        for (size_t i = 0; i < LINEAR_VIRTUAL_FRAME_LEN / LINEAR_VIRTUAL_ALLOC_SIZE; i += 1) {
+            uint8_t* buf = allocator_linear_virtual_alloc(arena, LINEAR_VIRTUAL_ALLOC_SIZE);
+            assert(buf != NULL && buf[0] == 0 && buf[LINEAR_VIRTUAL_ALLOC_SIZE - 1] == 0);
+            memset(buf, 0x5a, LINEAR_VIRTUAL_ALLOC_SIZE);
+        }
+
+        size_t committed = arena->linear.buf_len;
+        allocator_linear_virtual_free(arena, keep_committed);
+
+        if (keep_committed >= committed) {
+            assert(arena->linear.buf_len == committed);
+        } else {
+            assert(arena->linear.buf_len == align_forward_size(keep_committed, arena->commit_granule));
+        }
+    }
+
+    return (bench_now() - start) * 1e3 / LINEAR_VIRTUAL_FRAMES;
+}
+
+void bench_linear_virtual(void) {
+    printf("%d frames of %d MiB in %d KiB allocations, reset between frames\n\n", LINEAR_VIRTUAL_FRAMES, LINEAR_VIRTUAL_FRAME_LEN >> 20, LINEAR_VIRTUAL_ALLOC_SIZE >> 10);
+    printf("kept committed on reset   ms per frame\n");
+
+    struct {
+        const char* name;
+        size_t      keep_committed;
+    } runs[] = {
+        { "everything (SIZE_MAX)", SIZE_MAX                     },
+        { "half a frame",          LINEAR_VIRTUAL_FRAME_LEN / 2 },
+        { "nothing (0)",           0                            },
+    };
+
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i += 1) {
+        Allocator_Linear_Virtual arena;
+        bool ok = allocator_linear_virtual_init(&arena, LINEAR_VIRTUAL_RESERVE, LINEAR_VIRTUAL_GRANULE);
+        assert(ok);
+
+        printf("%-24s %12.2f\n", runs[i].name, linear_virtual_run(&arena, runs[i].keep_committed));
+        allocator_linear_virtual_destroy(&arena);
+    }
+}
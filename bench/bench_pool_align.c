@@ -0,0 +1,88 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define POOL_ALIGN_BUF_LEN    (256 * 1024)
+#define POOL_ALIGN_INCREMENTS (1 << 22) // Per thread
+
+typedef void (*Pool_Align_Init_Fn)(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align);
+
+/**
+ * Every chunk of a pool over a buffer starting at an odd address must honor the chunk alignment, 
+ * and stay inside the buffer.
+ */
+static void pool_align_check(Pool_Align_Init_Fn init, uint8_t* buf, size_t offset, size_t chunk_size, size_t chunk_align) {
+    Allocator_Pool pool;
+    init(&pool, buf + offset, POOL_ALIGN_BUF_LEN - offset, chunk_size, chunk_align);
+
+    size_t count = 0;
+    while (allocator_pool_has_free_chunk(&pool)) {
+        uint8_t* chunk = allocator_pool_alloc(&pool);
+        assert(((uintptr_t) chunk & (chunk_align - 1)) == 0);
+        assert(chunk >= buf + offset && chunk + chunk_size <= buf + POOL_ALIGN_BUF_LEN);
+        count += 1;
+    }
+    assert(count > 0);
+}
+
+typedef struct Pool_Align_Counters {
+    _Atomic uint64_t* counters[BENCH_MAX_THREADS];
+} Pool_Align_Counters;
+
+static void pool_align_worker(size_t thread_index, void* user_data) {
+    _Atomic uint64_t* counter = ((Pool_Align_Counters*) user_data)->counters[thread_index];
+
+    for (size_t i = 0; i < POOL_ALIGN_INCREMENTS; i += 1) {
+        atomic_fetch_add_explicit(counter, 1, memory_order_relaxed);
+    }
+}
+
+/**
+ * One counter per thread, each in a chunk of the pool. Returns the increments per second.
+ */
+static double pool_align_counters(uint8_t* buf, size_t thread_count, size_t chunk_size, size_t chunk_align) {
+    Allocator_Pool pool;
+    allocator_pool_init(&pool, buf, POOL_ALIGN_BUF_LEN, chunk_size, chunk_align);
+
+    Pool_Align_Counters counters;
+    for (size_t i = 0; i < thread_count; i += 1) {
+        counters.counters[i] = allocator_pool_alloc(&pool);
+    }
+
+    double elapsed = bench_run_threads(thread_count, pool_align_worker, &counters);
+
+    for (size_t i = 0; i < thread_count; i += 1) {
+        assert(atomic_load(counters.counters[i]) == POOL_ALIGN_INCREMENTS);
+    }
+    return (double) (thread_count * POOL_ALIGN_INCREMENTS) / elapsed;
+}
+
+void bench_pool_align(void) {
+    uint8_t* buf = malloc(POOL_ALIGN_BUF_LEN);
+    assert(buf != NULL);
+
+    const Pool_Align_Init_Fn inits[]   = { allocator_pool_init, allocator_pool_init_lazy, allocator_pool_init_tracked };
+    const size_t             aligns[]  = { 16, 64, 4096 };
+    const size_t             offsets[] = { 0, 1, 3, 7, 13, 63, 4095 };
+
+    for (size_t i = 0; i < sizeof(inits) / sizeof(inits[0]); i += 1) {
+        for (size_t a = 0; a < sizeof(aligns) / sizeof(aligns[0]); a += 1) {
+            for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o += 1) {
+                pool_align_check(inits[i], buf, offsets[o], aligns[a], aligns[a]);
+                pool_align_check(inits[i], buf, offsets[o], 24, aligns[a]);
+            }
+        }
+    }
+    printf("chunk alignments of 16, 64 and 4096 bytes hold over odd buffer offsets\n\n");
+
+    printf("%d relaxed atomic increments per thread on a per-thread counter, increments per second\n\n", POOL_ALIGN_INCREMENTS);
+    printf("threads  8 bytes chunks (shared lines)  64 bytes aligned chunks\n");
+    for (size_t thread_count = 1; thread_count <= BENCH_MAX_THREADS; thread_count *= 2) {
+        double packed = pool_align_counters(buf, thread_count, sizeof(uint64_t), sizeof(uint64_t));
+        double padded = pool_align_counters(buf, thread_count, ALLOCATOR_CACHE_LINE_SIZE, ALLOCATOR_CACHE_LINE_SIZE);
+        printf("%7zu  %26.1f M/s  %20.1f M/s\n", thread_count, packed * 1e-6, padded * 1e-6);
+    }
+
+    free(buf);
+}
@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define POOL_BATCH_CHUNK_SIZE  64
+#define POOL_BATCH_CHUNK_COUNT 4096
+#define POOL_BATCH_BUF_LEN     (POOL_BATCH_CHUNK_COUNT * POOL_BATCH_CHUNK_SIZE)
+#define POOL_BATCH_OPS         (1 << 23) // Chunks allocated then freed, for each batch size
+
+/**
+ * Allocates and frees bursts of `batch` chunks, with the batch API or one chunk at a time.
+ * Returns the time per chunk allocated and freed, in nanoseconds.
+ */
+static double pool_batch_run(Allocator_Pool* pool, void** ptrs, size_t batch, bool batched) {
+    double start = bench_now();
+
+    for (size_t done = 0; done < POOL_BATCH_OPS; done += batch) {
+        if (batched) {
+            size_t count = allocator_pool_alloc_n(pool, ptrs, batch);
+            assert(count == batch);
+        } else {
+            for (size_t i = 0; i < batch; i += 1) {
+                ptrs[i] = allocator_pool_alloc(pool);
+            }
+        }
+
+        // Touch the burst, as a message handler would
+        for (size_t i = 0; i < batch; i += 1) {
+            *(uint64_t*) ptrs[i] = done + i;
+        }
+
+        if (batched) {
+            allocator_pool_free_n(pool, ptrs, batch);
+        } else {
+            for (size_t i = 0; i < batch; i += 1) {
+                allocator_pool_free(pool, ptrs[i]);
+            }
+        }
+    }
+
+    return (bench_now() - start) / POOL_BATCH_OPS * 1e9;
+}
+
+/**
+ * Fills a lazy pool in bursts of `batch` chunks and resets it with `allocator_pool_free_all` once it
+ * is full, the way a per-frame pool is used: every chunk comes from the never handed out ones.
+ * Returns the time per chunk allocated, in nanoseconds.
+ */
+static double pool_batch_run_lazy(Allocator_Pool* pool, void** ptrs, size_t batch, bool batched) {
+    double start = bench_now();
+
+    for (size_t done = 0; done < POOL_BATCH_OPS; done += batch) {
+        if (!allocator_pool_has_free_chunk(pool)) {
+            allocator_pool_free_all(pool);
+        }
+
+        if (batched) {
+            size_t count = allocator_pool_alloc_n(pool, ptrs, batch);
+            assert(count == batch);
+        } else {
+            for (size_t i = 0; i < batch; i += 1) {
+                ptrs[i] = allocator_pool_alloc(pool);
+            }
+        }
+
+        for (size_t i = 0; i < batch; i += 1) {
+            *(uint64_t*) ptrs[i] = done + i;
+        }
+    }
+
+    return (bench_now() - start) / POOL_BATCH_OPS * 1e9;
+}
+
+void bench_pool_batch(void) {
+    void*  buf = malloc(POOL_BATCH_BUF_LEN);
+    void*  ptrs[256];
+    assert(buf != NULL);
+
+    // A batch taken across the free list and the unused chunks must be distinct and cleared
+    Allocator_Pool pool;
+    allocator_pool_init_lazy(&pool, buf, POOL_BATCH_BUF_LEN, POOL_BATCH_CHUNK_SIZE, 16);
+    assert(allocator_pool_alloc_n(&pool, ptrs, 64) == 64);
+    for (size_t i = 0; i < 64; i += 1) {
+        memset(ptrs[i], 0xff, POOL_BATCH_CHUNK_SIZE);
+    }
+    allocator_pool_free_n(&pool, ptrs, 32);
+    assert(allocator_pool_alloc_n(&pool, ptrs, 128) == 128);
+    for (size_t i = 0; i < 128; i += 1) {
+        for (size_t j = 0; j < POOL_BATCH_CHUNK_SIZE; j += 1) {
+            assert(((uint8_t*) ptrs[i])[j] == 0);
+        }
+        for (size_t j = 0; j < i; j += 1) {
+            assert(ptrs[i] != ptrs[j]);
+        }
+    }
+
+    // Running out is reported by the count, never past the end of the buffer
+    allocator_pool_free_all(&pool);
+    size_t total = 0;
+    for (size_t count = 1; count > 0; total += count) {
+        count = allocator_pool_alloc_n(&pool, ptrs, 256);
+    }
+    assert(total == POOL_BATCH_CHUNK_COUNT);
+
+    // A run of unused chunks is marked live a word at a time, from an index inside a word
+    allocator_pool_init_tracked(&pool, buf, POOL_BATCH_BUF_LEN, POOL_BATCH_CHUNK_SIZE, 16);
+    void*  first       = allocator_pool_alloc(&pool);
+    size_t chunk_count = pool.buf_len / pool.chunk_size;
+    assert(allocator_pool_alloc_n(&pool, ptrs, 200) == 200);
+    size_t live = 0;
+    for (size_t i = allocator_pool_next_live(&pool, 0); i < chunk_count; i = allocator_pool_next_live(&pool, i + 1)) {
+        assert(i == live);
+        live += 1;
+    }
+    assert(live == 201);
+    allocator_pool_free_n(&pool, ptrs, 200);
+    assert(allocator_pool_next_live(&pool, 0) == 0 && allocator_pool_next_live(&pool, 1) == chunk_count);
+    allocator_pool_free(&pool, first);
+
+    printf("%d chunks of %d bytes allocated and freed in bursts, ns per chunk\n\n", POOL_BATCH_OPS, POOL_BATCH_CHUNK_SIZE);
+    printf("       eager pool, alloc and free      lazy pool, alloc and free_all\n");
+    printf("batch  batch calls  one chunk per call  batch calls  one chunk per call\n");
+
+    const size_t batches[] = { 32, 64, 256 };
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b += 1) {
+        allocator_pool_init(&pool, buf, POOL_BATCH_BUF_LEN, POOL_BATCH_CHUNK_SIZE, 16);
+        double batched = pool_batch_run(&pool, ptrs, batches[b], true);
+
+        allocator_pool_init(&pool, buf, POOL_BATCH_BUF_LEN, POOL_BATCH_CHUNK_SIZE, 16);
+        double single = pool_batch_run(&pool, ptrs, batches[b], false);
+
+        allocator_pool_init_lazy(&pool, buf, POOL_BATCH_BUF_LEN, POOL_BATCH_CHUNK_SIZE, 16);
+        double lazy_batched = pool_batch_run_lazy(&pool, ptrs, batches[b], true);
+
+        allocator_pool_init_lazy(&pool, buf, POOL_BATCH_BUF_LEN, POOL_BATCH_CHUNK_SIZE, 16);
+        double lazy_single = pool_batch_run_lazy(&pool, ptrs, batches[b], false);
+
+        printf("%5zu  %11.2f  %18.2f  %11.2f  %18.2f\n", batches[b], batched, single, lazy_batched, lazy_single);
+    }
+
+    free(buf);
+}
@@ -0,0 +1,104 @@
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define POOL_BITMAP_CHUNK_SIZE  64
+#define POOL_BITMAP_CHUNK_COUNT (1 << 20)
+#define POOL_BITMAP_BUF_LEN     (POOL_BITMAP_CHUNK_COUNT * POOL_BITMAP_CHUNK_SIZE + POOL_BITMAP_CHUNK_COUNT / 4 + 4096) // Room for the bitmaps
+#define POOL_BITMAP_ROUNDS      8
+
+typedef struct Pool_Bitmap_Object {
+    uint64_t value;
+    uint64_t payload[7];
+} Pool_Bitmap_Object;
+
+typedef struct Pool_Bitmap_Result {
+    double churn;
+    double traversal;
+} Pool_Bitmap_Result;
+
+/**
+ * Frees half of the objects at random then allocates them again, `POOL_BITMAP_ROUNDS` times, then 
+ * sums the objects in allocation order. The free list pool hands the chunks back in the random order 
+ * they were freed, the bitmap pool in address order.
+ */
+static Pool_Bitmap_Result pool_bitmap_run(void* pool, bool bitmap, void** ptrs, size_t count) {
+    uint64_t           seed   = 0x9e3779b97f4a7c15;
+    Pool_Bitmap_Result result = { 0.0, 0.0 };
+
+    for (size_t i = 0; i < count; i += 1) {
+        ptrs[i] = bitmap ? allocator_pool_bitmap_alloc(pool) : allocator_pool_alloc(pool);
+        assert(ptrs[i] != NULL);
+    }
+
+    double start = bench_now();
+    for (size_t round = 0; round < POOL_BITMAP_ROUNDS; round += 1) {
+        bench_shuffle(ptrs, count, &seed);
+        for (size_t i = 0; i < count / 2; i += 1) {
+            if (bitmap) {
+                allocator_pool_bitmap_free(pool, ptrs[i]);
+            } else {
+                allocator_pool_free(pool, ptrs[i]);
+            }
+        }
+        for (size_t i = 0; i < count / 2; i += 1) {
+            ptrs[i] = bitmap ? allocator_pool_bitmap_alloc(pool) : allocator_pool_alloc(pool);
+            ((Pool_Bitmap_Object*) ptrs[i])->value = i;
+        }
+    }
+    result.churn = bench_now() - start;
+
+    start = bench_now();
+    uint64_t sum = 0;
+    for (size_t pass = 0; pass < 4; pass += 1) {
+        for (size_t i = 0; i < count / 2; i += 1) {
+            sum += ((Pool_Bitmap_Object*) ptrs[i])->value;
+        }
+    }
+    result.traversal = bench_now() - start;
+    assert(sum == 4 * ((uint64_t) (count / 2) * (count / 2 - 1) / 2));
+
+    return result;
+}
+
+void bench_pool_bitmap(void) {
+    void*  buf  = malloc(POOL_BITMAP_BUF_LEN);
+    void** ptrs = malloc(POOL_BITMAP_CHUNK_COUNT * sizeof(void*));
+    assert(buf != NULL && ptrs != NULL);
+
+    Allocator_Pool_Bitmap bitmap_pool;
+    allocator_pool_bitmap_init(&bitmap_pool, buf, POOL_BITMAP_BUF_LEN, POOL_BITMAP_CHUNK_SIZE, 64);
+    assert(bitmap_pool.chunk_count >= POOL_BITMAP_CHUNK_COUNT);
+
+    // The bitmap pool always hands out the lowest free chunk
+    void* first  = allocator_pool_bitmap_alloc(&bitmap_pool);
+    void* second = allocator_pool_bitmap_alloc(&bitmap_pool);
+    void* third  = allocator_pool_bitmap_alloc(&bitmap_pool);
+    assert((uint8_t*) second == (uint8_t*) first + POOL_BITMAP_CHUNK_SIZE && (uint8_t*) third == (uint8_t*) second + POOL_BITMAP_CHUNK_SIZE);
+    allocator_pool_bitmap_free(&bitmap_pool, second);
+    assert(allocator_pool_bitmap_alloc(&bitmap_pool) == second);
+    allocator_pool_bitmap_free_all(&bitmap_pool);
+
+    Pool_Bitmap_Result bitmap = pool_bitmap_run(&bitmap_pool, true, ptrs, POOL_BITMAP_CHUNK_COUNT);
+
+    // Every chunk is live, the iteration must visit them all in address order
+    size_t live = 0;
+    for (size_t i = allocator_pool_bitmap_next_live(&bitmap_pool, 0); i < bitmap_pool.chunk_count; i = allocator_pool_bitmap_next_live(&bitmap_pool, i + 1)) {
+        live += 1;
+    }
+    assert(live == POOL_BITMAP_CHUNK_COUNT);
+
+    Allocator_Pool list_pool;
+    allocator_pool_init(&list_pool, buf, POOL_BITMAP_BUF_LEN, POOL_BITMAP_CHUNK_SIZE, 64);
+    Pool_Bitmap_Result list = pool_bitmap_run(&list_pool, false, ptrs, POOL_BITMAP_CHUNK_COUNT);
+
+    printf("%d chunks of %d bytes, %d rounds freeing and allocating half of them at random\n\n", POOL_BITMAP_CHUNK_COUNT, POOL_BITMAP_CHUNK_SIZE, POOL_BITMAP_ROUNDS);
+    printf("                        churn (ns/op)   traversal after churn (ns/object)\n");
+    double ops     = (double) POOL_BITMAP_ROUNDS * POOL_BITMAP_CHUNK_COUNT;
+    double visited = 4.0 * (POOL_BITMAP_CHUNK_COUNT / 2);
+    printf("Allocator_Pool_Bitmap   %13.1f   %33.2f\n", bitmap.churn / ops * 1e9, bitmap.traversal / visited * 1e9);
+    printf("Allocator_Pool          %13.1f   %33.2f\n", list.churn / ops * 1e9, list.traversal / visited * 1e9);
+
+    free(ptrs);
+    free(buf);
+}
@@ -0,0 +1,106 @@
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "bench.h"
+
+#define POOL_COLORING_SLAB_SIZE  (64 * 1024)
+#define POOL_COLORING_CHUNK_SIZE 4096
+#define POOL_COLORING_OBJECTS    512
+#define POOL_COLORING_PASSES     2000
+
+/**
+ * Opens a counter of the L1 data cache read misses of the calling thread, -1 if perf is not available.
+ */
+static int pool_coloring_counter_open(void) {
+#if defined(__linux__)
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HW_CACHE;
+    attr.config         = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+typedef struct Pool_Coloring_Result {
+    double   time;
+    uint64_t misses;
+    bool     counted;
+} Pool_Coloring_Result;
+
+/**
+ * Allocates 4 KiB objects from a growable pool and reads the hot header (first cache line) of each 
+ * of them, over and over. Without coloring, every header sits at the same offset modulo 4 KiB and 
+ * falls in the same L1 set.
+ */
+static Pool_Coloring_Result pool_coloring_run(size_t color_step) {
+    Allocator_Pool_Growable pool;
+    allocator_pool_growable_init(&pool, ALLOCATOR_BACKING_MMAP, POOL_COLORING_SLAB_SIZE, POOL_COLORING_CHUNK_SIZE, 64, 0);
+    allocator_pool_growable_set_coloring(&pool, color_step);
+
+    uint64_t* objects[POOL_COLORING_OBJECTS];
+    for (size_t i = 0; i < POOL_COLORING_OBJECTS; i += 1) {
+        objects[i] = allocator_pool_growable_alloc(&pool);
+        assert(objects[i] != NULL && ((uintptr_t) objects[i] & 63) == 0);
+        objects[i][0] = i;
+    }
+
+    Pool_Coloring_Result result  = { 0.0, 0, false };
+    int                  counter = pool_coloring_counter_open();
+
+#if defined(__linux__)
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+
+    double   start = bench_now();
+    uint64_t sum   = 0;
+    for (size_t pass = 0; pass < POOL_COLORING_PASSES; pass += 1) {
+        for (size_t i = 0; i < POOL_COLORING_OBJECTS; i += 1) {
+            sum += *(volatile uint64_t*) objects[i];
+        }
+    }
+    result.time = bench_now() - start;
+
+#if defined(__linux__)
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        result.counted = read(counter, &result.misses, sizeof(result.misses)) == sizeof(result.misses);
+        close(counter);
+    }
+#endif
+
+    assert(sum == POOL_COLORING_PASSES * ((uint64_t) POOL_COLORING_OBJECTS * (POOL_COLORING_OBJECTS - 1) / 2));
+    allocator_pool_growable_destroy(&pool);
+    return result;
+}
+
+static void pool_coloring_print(const char* name, Pool_Coloring_Result result) {
+    double reads = (double) POOL_COLORING_PASSES * POOL_COLORING_OBJECTS;
+    if (result.counted) {
+        printf("%-18s %6.2f ns/read  %6.3f L1d misses/read\n", name, result.time / reads * 1e9, (double) result.misses / reads);
+    } else {
+        printf("%-18s %6.2f ns/read  (L1d miss counter not available)\n", name, result.time / reads * 1e9);
+    }
+}
+
+void bench_pool_coloring(void) {
+    printf("Hot first cache line of %d chunks of %d bytes, in %d KiB slabs\n\n", POOL_COLORING_OBJECTS, POOL_COLORING_CHUNK_SIZE, POOL_COLORING_SLAB_SIZE / 1024);
+
+    pool_coloring_print("no coloring", pool_coloring_run(0));
+    pool_coloring_print("64 bytes colors", pool_coloring_run(64));
+}
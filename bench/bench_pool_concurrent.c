@@ -0,0 +1,89 @@
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define POOL_CONCURRENT_CHUNK_SIZE  64
+#define POOL_CONCURRENT_CHUNK_COUNT 4096
+#define POOL_CONCURRENT_BUF_LEN     (POOL_CONCURRENT_CHUNK_COUNT * POOL_CONCURRENT_CHUNK_SIZE)
+#define POOL_CONCURRENT_BATCH       16
+#define POOL_CONCURRENT_ROUNDS      (1 << 15) // Per thread
+
+typedef struct Pool_Mutex {
+    Allocator_Pool  pool;
+    pthread_mutex_t lock;
+} Pool_Mutex;
+
+typedef struct Pool_Concurrent_Bench {
+    Allocator_Pool_Concurrent* concurrent; // NULL when the mutex pool is measured
+    Pool_Mutex*                locked;
+} Pool_Concurrent_Bench;
+
+/**
+ * Each thread takes a batch of chunks, stamps them, checks its stamps are still there, and gives 
+ * them back: a chunk handed out to two threads at once trips the check.
+ */
+static void pool_concurrent_worker(size_t thread_index, void* user_data) {
+    Pool_Concurrent_Bench* bench = (Pool_Concurrent_Bench*) user_data;
+    uint64_t*              chunks[POOL_CONCURRENT_BATCH];
+
+    for (uint64_t round = 0; round < POOL_CONCURRENT_ROUNDS; round += 1) {
+        uint64_t stamp = (thread_index << 48) | round;
+
+        for (size_t i = 0; i < POOL_CONCURRENT_BATCH; i += 1) {
+            if (bench->concurrent != NULL) {
+                chunks[i] = allocator_pool_concurrent_alloc(bench->concurrent);
+            } else {
+                pthread_mutex_lock(&bench->locked->lock);
+                chunks[i] = allocator_pool_alloc(&bench->locked->pool);
+                pthread_mutex_unlock(&bench->locked->lock);
+            }
+            assert(chunks[i] != NULL);
+            *chunks[i] = stamp;
+        }
+
+        for (size_t i = 0; i < POOL_CONCURRENT_BATCH; i += 1) {
+            assert(*chunks[i] == stamp);
+            if (bench->concurrent != NULL) {
+                allocator_pool_concurrent_free(bench->concurrent, chunks[i]);
+            } else {
+                pthread_mutex_lock(&bench->locked->lock);
+                allocator_pool_free(&bench->locked->pool, chunks[i]);
+                pthread_mutex_unlock(&bench->locked->lock);
+            }
+        }
+    }
+}
+
+void bench_pool_concurrent(void) {
+    void* buf = malloc(POOL_CONCURRENT_BUF_LEN);
+    assert(buf != NULL);
+
+    printf("%d rounds of %d allocations then frees per thread, operations per second\n\n", POOL_CONCURRENT_ROUNDS, POOL_CONCURRENT_BATCH);
+    printf("threads  Allocator_Pool_Concurrent  mutex + Allocator_Pool\n");
+
+    for (size_t thread_count = 1; thread_count <= BENCH_MAX_THREADS; thread_count *= 2) {
+        Allocator_Pool_Concurrent concurrent;
+        allocator_pool_concurrent_init(&concurrent, buf, POOL_CONCURRENT_BUF_LEN, POOL_CONCURRENT_CHUNK_SIZE, 64);
+        Pool_Concurrent_Bench concurrent_bench = { &concurrent, NULL };
+        double concurrent_time = bench_run_threads(thread_count, pool_concurrent_worker, &concurrent_bench);
+
+        // Nothing was lost in the races: every chunk can still be allocated, and no more
+        for (size_t i = 0; i < concurrent.chunk_count; i += 1) {
+            assert(allocator_pool_concurrent_alloc(&concurrent) != NULL);
+        }
+        assert(allocator_pool_concurrent_alloc(&concurrent) == NULL);
+
+        Pool_Mutex locked;
+        allocator_pool_init(&locked.pool, buf, POOL_CONCURRENT_BUF_LEN, POOL_CONCURRENT_CHUNK_SIZE, 64);
+        pthread_mutex_init(&locked.lock, NULL);
+        Pool_Concurrent_Bench locked_bench = { NULL, &locked };
+        double locked_time = bench_run_threads(thread_count, pool_concurrent_worker, &locked_bench);
+        pthread_mutex_destroy(&locked.lock);
+
+        double ops = 2.0 * (double) (thread_count * POOL_CONCURRENT_ROUNDS * POOL_CONCURRENT_BATCH);
+        printf("%7zu  %22.1f M/s  %19.1f M/s\n", thread_count, ops / concurrent_time * 1e-6, ops / locked_time * 1e-6);
+    }
+
+    free(buf);
+}
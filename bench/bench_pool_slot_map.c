@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define POOL_SLOT_MAP_CHUNK_SIZE 16
+#define POOL_SLOT_MAP_CAPACITY   1024
+#define POOL_SLOT_MAP_BUF_LEN    (POOL_SLOT_MAP_CAPACITY * (POOL_SLOT_MAP_CHUNK_SIZE + sizeof(Allocator_Pool_Slot) + sizeof(uint32_t)) + POOL_SLOT_MAP_CHUNK_SIZE)
+#define POOL_SLOT_MAP_CYCLES     (3 * (ALLOCATOR_POOL_HANDLE_GENERATION_MAX + 1) * POOL_SLOT_MAP_CAPACITY)
+
+/**
+ * Frees the oldest of `live` objects and allocates a new one, `POOL_SLOT_MAP_CYCLES` times. Every
+ * slot goes through its generations about three times over, a map retiring its slots would run out
+ * of memory long before the end. Returns the time per free and alloc, in nanoseconds.
+ */
+static double pool_slot_map_run(Allocator_Pool_Slot_Map* map, Allocator_Pool_Handle* handles, size_t live) {
+    for (size_t i = 0; i < live; i += 1) {
+        handles[i] = allocator_pool_slot_map_alloc(map);
+        *(uint64_t*) allocator_pool_slot_map_get(map, handles[i]) = handles[i];
+    }
+
+    double start = bench_now();
+
+    for (size_t cycle = 0; cycle < POOL_SLOT_MAP_CYCLES; cycle += 1) {
+        size_t index = live > 0 ? cycle % live : 0;
+
+        if (live > 0) {
+            assert(*(uint64_t*) allocator_pool_slot_map_get(map, handles[index]) == handles[index]);
+            allocator_pool_slot_map_free(map, handles[index]);
+            assert(allocator_pool_slot_map_get(map, handles[index]) == NULL);
+        }
+
+        Allocator_Pool_Handle handle = allocator_pool_slot_map_alloc(map);
+        assert(handle != ALLOCATOR_POOL_HANDLE_NULL);
+
+        uint64_t* object = allocator_pool_slot_map_get(map, handle);
+        assert(object != NULL && object[0] == 0 && object[1] == 0);
+        object[0] = handle;
+
+        if (live > 0) {
+            handles[index] = handle;
+        } else {
+            allocator_pool_slot_map_free(map, handle);
+            assert(allocator_pool_slot_map_get(map, handle) == NULL);
+        }
+    }
+
+    double time = bench_now() - start;
+
+    assert(map->count == live);
+    allocator_pool_slot_map_free_all(map);
+    for (size_t i = 0; i < live; i += 1) {
+        assert(allocator_pool_slot_map_get(map, handles[i]) == NULL);
+    }
+
+    return time * 1e9 / POOL_SLOT_MAP_CYCLES;
+}
+
+void bench_pool_slot_map(void) {
+    void*                  buf     = malloc(POOL_SLOT_MAP_BUF_LEN);
+    Allocator_Pool_Handle* handles = calloc(POOL_SLOT_MAP_CAPACITY, sizeof(Allocator_Pool_Handle));
+    assert(buf != NULL && handles != NULL);
+
+    Allocator_Pool_Slot_Map map;
+    allocator_pool_slot_map_init(&map, buf, POOL_SLOT_MAP_BUF_LEN, POOL_SLOT_MAP_CHUNK_SIZE, POOL_SLOT_MAP_CHUNK_SIZE);
+    assert(map.capacity == POOL_SLOT_MAP_CAPACITY);
+
+    printf("%d slots, %zu free and alloc cycles per row, %zu generations per slot\n\n", POOL_SLOT_MAP_CAPACITY, (size_t) POOL_SLOT_MAP_CYCLES, (size_t) ALLOCATOR_POOL_HANDLE_GENERATION_MAX);
+    printf("live objects   ns per cycle\n");
+
+    size_t lives[] = { 0, POOL_SLOT_MAP_CAPACITY / 2, POOL_SLOT_MAP_CAPACITY - 1 };
+    for (size_t i = 0; i < sizeof(lives) / sizeof(lives[0]); i += 1) {
+        double time = pool_slot_map_run(&map, handles, lives[i]);
+        printf("%12zu %14.1f\n", lives[i], time);
+    }
+
+    // Every slot is still in use after the generations wrapped: the map can be filled again
+    for (size_t i = 0; i < POOL_SLOT_MAP_CAPACITY; i += 1) {
+        assert(allocator_pool_slot_map_alloc(&map) != ALLOCATOR_POOL_HANDLE_NULL);
+    }
+
+    free(handles);
+    free(buf);
+}
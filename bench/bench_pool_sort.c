@@ -0,0 +1,107 @@
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define POOL_SORT_CHUNK_COUNT (1 << 20)
+#define POOL_SORT_PASSES      2
+
+typedef struct Pool_Sort_Node Pool_Sort_Node;
+struct Pool_Sort_Node {
+    Pool_Sort_Node* next;
+    uint64_t        value;
+    uint64_t        payload[6];
+};
+
+/**
+ * Allocates a linked list over every chunk of the pool, then walks it. Returns the walk time per node, 
+ * in nanoseconds.
+ */
+static double pool_sort_traverse(Allocator_Pool* pool) {
+    Pool_Sort_Node* head = NULL;
+    Pool_Sort_Node* tail = NULL;
+
+    for (size_t i = 0; i < POOL_SORT_CHUNK_COUNT; i += 1) {
+        Pool_Sort_Node* node = allocator_pool_alloc(pool);
+        node->value = i;
+        if (tail != NULL) {
+            tail->next = node;
+        } else {
+            head = node;
+        }
+        tail = node;
+    }
+
+    double   start = bench_now();
+    uint64_t sum   = 0;
+    for (size_t pass = 0; pass < POOL_SORT_PASSES; pass += 1) {
+        for (Pool_Sort_Node* node = head; node != NULL; node = node->next) {
+            sum += node->value;
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    assert(sum == POOL_SORT_PASSES * ((uint64_t) POOL_SORT_CHUNK_COUNT * (POOL_SORT_CHUNK_COUNT - 1) / 2));
+    return elapsed / ((double) POOL_SORT_PASSES * POOL_SORT_CHUNK_COUNT) * 1e9;
+}
+
+/**
+ * Allocates every chunk, then frees them all in a random order: the free list ends up shuffled, as 
+ * after a long run of random frees.
+ */
+static void pool_sort_scramble(Allocator_Pool* pool, void** ptrs) {
+    uint64_t seed = 0x2545f4914f6cdd1d;
+
+    for (size_t i = 0; i < POOL_SORT_CHUNK_COUNT; i += 1) {
+        ptrs[i] = allocator_pool_alloc(pool);
+    }
+    bench_shuffle(ptrs, POOL_SORT_CHUNK_COUNT, &seed);
+    for (size_t i = 0; i < POOL_SORT_CHUNK_COUNT; i += 1) {
+        allocator_pool_free(pool, ptrs[i]);
+    }
+}
+
+void bench_pool_sort(void) {
+    // Page aligned, so the untracked pools hold exactly POOL_SORT_CHUNK_COUNT chunks
+    size_t buf_len = POOL_SORT_CHUNK_COUNT * sizeof(Pool_Sort_Node) + POOL_SORT_CHUNK_COUNT / 8 + 4096; // Room for the tracked bitmap
+    void*  buf     = ALLOCATOR_BACKING_MMAP.alloc(NULL, buf_len, 0);
+    void** ptrs    = malloc(POOL_SORT_CHUNK_COUNT * sizeof(void*));
+    assert(buf != NULL && ptrs != NULL);
+
+    printf("Linked list over %d chunks of %zu bytes, walk time per node\n\n", POOL_SORT_CHUNK_COUNT, sizeof(Pool_Sort_Node));
+
+    Allocator_Pool pool;
+    allocator_pool_init(&pool, buf, POOL_SORT_CHUNK_COUNT * sizeof(Pool_Sort_Node), sizeof(Pool_Sort_Node), 64);
+    printf("after allocator_pool_init                %6.2f ns\n", pool_sort_traverse(&pool));
+
+    allocator_pool_init(&pool, buf, POOL_SORT_CHUNK_COUNT * sizeof(Pool_Sort_Node), sizeof(Pool_Sort_Node), 64);
+    pool_sort_scramble(&pool, ptrs);
+    printf("after random frees                       %6.2f ns\n", pool_sort_traverse(&pool));
+
+    allocator_pool_init(&pool, buf, POOL_SORT_CHUNK_COUNT * sizeof(Pool_Sort_Node), sizeof(Pool_Sort_Node), 64);
+    pool_sort_scramble(&pool, ptrs);
+    double start = bench_now();
+    allocator_pool_sort_free_list(&pool);
+    double sort_time = bench_now() - start;
+
+    // The rebuilt free list hands the chunks out by increasing address
+    void* previous = allocator_pool_alloc(&pool);
+    for (size_t i = 1; i < 1024; i += 1) {
+        void* next = allocator_pool_alloc(&pool);
+        assert((uint8_t*) next == (uint8_t*) previous + sizeof(Pool_Sort_Node));
+        previous = next;
+    }
+    allocator_pool_free_all(&pool);
+    pool_sort_scramble(&pool, ptrs);
+    allocator_pool_sort_free_list(&pool);
+    printf("after random frees + sort (merge sort)   %6.2f ns, sort took %.1f ms\n", pool_sort_traverse(&pool), sort_time * 1e3);
+
+    allocator_pool_init_tracked(&pool, buf, buf_len, sizeof(Pool_Sort_Node), 64);
+    pool_sort_scramble(&pool, ptrs);
+    start = bench_now();
+    allocator_pool_sort_free_list(&pool);
+    sort_time = bench_now() - start;
+    printf("after random frees + sort (tracked pool) %6.2f ns, sort took %.1f ms\n", pool_sort_traverse(&pool), sort_time * 1e3);
+
+    free(ptrs);
+    ALLOCATOR_BACKING_MMAP.free(NULL, buf, buf_len);
+}
@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define SLAB_SLOTS    16384
+#define SLAB_STEPS    (1 << 22)
+#define SLAB_MAX_SIZE 1024
+
+typedef enum Slab_Target {
+    SLAB_TARGET_SLAB,
+    SLAB_TARGET_POOL,
+    SLAB_TARGET_MALLOC,
+} Slab_Target;
+
+/**
+ * Replaces random slots with allocations of random sizes, one in 1024 of them a large object. The 
+ * growable pool has a single class, as large as the largest size, and takes no large object. The
+ * allocators zero the memory they hand out, malloc is called through calloc to do the same.
+ */
+static double slab_run(Slab_Target target, void* allocator) {
+    static void* slots[SLAB_SLOTS];
+    memset(slots, 0, sizeof(slots));
+
+    uint64_t seed  = 0x8c5e21a6f3b7d049;
+    double   start = bench_now();
+
+    for (size_t step = 0; step < SLAB_STEPS; step += 1) {
+        uint64_t random = bench_random(&seed);
+        size_t   index  = (size_t) (random % SLAB_SLOTS);
+        size_t   size   = (size_t) ((random >> 16) % SLAB_MAX_SIZE) + 1;
+        if (target != SLAB_TARGET_POOL && ((random >> 32) & 1023) == 0) {
+            size = 64 * 1024;
+        }
+
+        switch (target) {
+            case SLAB_TARGET_SLAB:
+                // No size is passed back on free
+                allocator_slab_free(allocator, slots[index]);
+                slots[index] = allocator_slab_alloc(allocator, size);
+                assert(slots[index] != NULL && allocator_slab_usable_size(allocator, slots[index]) >= size);
+                break;
+            case SLAB_TARGET_POOL:
+                if (slots[index] != NULL) {
+                    allocator_pool_growable_free(allocator, slots[index]);
+                }
+                slots[index] = allocator_pool_growable_alloc(allocator);
+                assert(slots[index] != NULL);
+                break;
+            default:
+                free(slots[index]);
+                slots[index] = calloc(1, size);
+                assert(slots[index] != NULL);
+                break;
+        }
+
+        // Touch the object, as its user would
+        *(size_t*) slots[index] = size;
+    }
+
+    double time = bench_now() - start;
+
+    for (size_t i = 0; i < SLAB_SLOTS; i += 1) {
+        switch (target) {
+            case SLAB_TARGET_SLAB: allocator_slab_free(allocator, slots[i]);          break;
+            case SLAB_TARGET_POOL: allocator_pool_growable_free(allocator, slots[i]); break;
+            default:               free(slots[i]);                                    break;
+        }
+    }
+
+    return time;
+}
+
+void bench_slab(void) {
+    printf("%d steps replacing one of %d live objects of 1 to %d bytes, 1 in 1024 of 64 KiB\n\n", SLAB_STEPS, SLAB_SLOTS, SLAB_MAX_SIZE);
+
+    Allocator_Slab slab;
+    allocator_slab_init(&slab, ALLOCATOR_BACKING_MMAP, NULL, 0, 2);
+    double slab_time = slab_run(SLAB_TARGET_SLAB, &slab);
+
+    // Resizing inside the chunk keeps the object in place, the size class decides how far it goes
+    void* object = allocator_slab_alloc(&slab, 100);
+    assert(allocator_slab_resize(&slab, object, 100, allocator_slab_usable_size(&slab, object)) == object);
+    allocator_slab_free(&slab, object);
+    allocator_slab_destroy(&slab);
+
+    Allocator_Pool_Growable pool;
+    allocator_pool_growable_init(&pool, ALLOCATOR_BACKING_MMAP, ALLOCATOR_SLAB_SLAB_SIZE, SLAB_MAX_SIZE, DEFAULT_ALIGNEMENT, 2);
+    double pool_time = slab_run(SLAB_TARGET_POOL, &pool);
+    allocator_pool_growable_destroy(&pool);
+
+    double malloc_time = slab_run(SLAB_TARGET_MALLOC, NULL);
+
+    printf("Allocator_Slab                    %6.1f ns per free and alloc\n", slab_time * 1e9 / SLAB_STEPS);
+    printf("Allocator_Pool_Growable, 1 class  %6.1f ns per free and alloc\n", pool_time * 1e9 / SLAB_STEPS);
+    printf("glibc calloc                      %6.1f ns per free and alloc\n", malloc_time * 1e9 / SLAB_STEPS);
+}
@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define TLSF_BUF_LEN  (64 * 1024 * 1024)
+#define TLSF_SLOTS    8192
+#define TLSF_STEPS    (1 << 19)
+#define TLSF_MAX_SIZE 8192
+
+typedef enum Tlsf_Target {
+    TLSF_TARGET_TLSF,
+    TLSF_TARGET_MALLOC,
+    TLSF_TARGET_FREE_LIST,
+} Tlsf_Target;
+
+static void* tlsf_target_alloc(Tlsf_Target target, void* allocator, size_t size) {
+    switch (target) {
+        case TLSF_TARGET_TLSF:      return allocator_tlsf_alloc(allocator, size);
+        case TLSF_TARGET_FREE_LIST: return allocator_free_list_alloc(allocator, size);
+        default:                    return calloc(1, size);
+    }
+}
+
+static void tlsf_target_free(Tlsf_Target target, void* allocator, void* ptr) {
+    switch (target) {
+        case TLSF_TARGET_TLSF:      allocator_tlsf_free(allocator, ptr);      break;
+        case TLSF_TARGET_FREE_LIST: allocator_free_list_free(allocator, ptr); break;
+        default:                    free(ptr);                                break;
+    }
+}
+
+static int tlsf_compare(const void* a, const void* b) {
+    float x = *(const float*) a;
+    float y = *(const float*) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Replaces random slots with allocations of random sizes, timing each free and each allocation on 
+ * its own. The latencies include the cost of reading the clock.
+ */
+static void tlsf_run(const char* name, Tlsf_Target target, void* allocator, float* latencies) {
+    static void*    slots[TLSF_SLOTS];
+    static uint32_t stamps[TLSF_SLOTS];
+    memset(slots, 0, sizeof(slots));
+
+    uint64_t seed  = 0xda942042e4dd58b5;
+    size_t   count = 0;
+
+    for (size_t step = 0; step < TLSF_STEPS; step += 1) {
+        size_t index = (size_t) (bench_random(&seed) % TLSF_SLOTS);
+        size_t size  = (size_t) (bench_random(&seed) % TLSF_MAX_SIZE) + 1;
+
+        if (slots[index] != NULL) {
+            // A block handed out twice would have lost its stamp
+            assert(*(uint32_t*) slots[index] == stamps[index]);
+
+            double start = bench_now();
+            tlsf_target_free(target, allocator, slots[index]);
+            latencies[count++] = (float) ((bench_now() - start) * 1e9);
+        }
+
+        double start = bench_now();
+        slots[index] = tlsf_target_alloc(target, allocator, size);
+        latencies[count++] = (float) ((bench_now() - start) * 1e9);
+
+        assert(slots[index] != NULL && ((uintptr_t) slots[index] & (DEFAULT_ALIGNEMENT - 1)) == 0);
+        stamps[index] = (uint32_t) step;
+        *(uint32_t*) slots[index] = stamps[index];
+    }
+
+    for (size_t i = 0; i < TLSF_SLOTS; i += 1) {
+        tlsf_target_free(target, allocator, slots[i]);
+    }
+
+    qsort(latencies, count, sizeof(float), tlsf_compare);
+    printf("%-20s %8.0f %8.0f %8.0f %8.0f %9.0f\n", name,
+        latencies[count / 2], latencies[count * 99 / 100], latencies[count * 999 / 1000], latencies[count * 9999 / 10000], latencies[count - 1]);
+}
+
+void bench_tlsf(void) {
+    void*  buf       = malloc(TLSF_BUF_LEN);
+    float* latencies = malloc(2 * TLSF_STEPS * sizeof(float));
+    assert(buf != NULL && latencies != NULL);
+
+    printf("%d steps replacing one of %d live blocks of up to %d bytes, latency of each alloc and free in ns\n\n", TLSF_STEPS, TLSF_SLOTS, TLSF_MAX_SIZE);
+    printf("                          p50      p99    p99.9   p99.99       max\n");
+
+    Allocator_Tlsf tlsf;
+    allocator_tlsf_init(&tlsf, buf, TLSF_BUF_LEN);
+    tlsf_run("Allocator_Tlsf", TLSF_TARGET_TLSF, &tlsf, latencies);
+
+    // Everything was freed and merged: the whole buffer can be allocated again
+    void* all = allocator_tlsf_alloc(&tlsf, TLSF_BUF_LEN / 2);
+    assert(all != NULL);
+    allocator_tlsf_free(&tlsf, all);
+
+    tlsf_run("glibc malloc", TLSF_TARGET_MALLOC, NULL, latencies);
+
+    Allocator_Free_List free_list;
+    allocator_free_list_init(&free_list, buf, TLSF_BUF_LEN);
+    tlsf_run("free list first fit", TLSF_TARGET_FREE_LIST, &free_list, latencies);
+
+    free(latencies);
+    free(buf);
+}
@@ -0,0 +1,78 @@
+#include <string.h>
+
+#include "bench.h"
+
+#define ZEROING_BUF_LEN    (64 * 1024 * 1024)
+#define ZEROING_ALLOC_SIZE (1024 * 1024)
+#define ZEROING_PASSES     4
+
+/**
+ * Fills the arena with buffers which are overwritten right away, the case where zeroing is wasted.
+ * Returns the time taken, in seconds.
+ */
+static double zeroing_pass(Allocator_Linear* arena, bool no_zero) {
+    double start = bench_now();
+
+    for (size_t i = 0; i < ZEROING_BUF_LEN / ZEROING_ALLOC_SIZE; i += 1) {
+        uint8_t* buf = no_zero
+            ? allocator_linear_alloc_no_zero(arena, ZEROING_ALLOC_SIZE)
+            : allocator_linear_alloc(arena, ZEROING_ALLOC_SIZE);
+        assert(buf != NULL);
+
+        // Spot check that the zeroing policies hand out cleared memory, fresh or reused
+        if (!no_zero && arena->zero_policy != ALLOCATOR_ZERO_NEVER) {
+            assert(buf[0] == 0 && buf[ZEROING_ALLOC_SIZE / 2] == 0 && buf[ZEROING_ALLOC_SIZE - 1] == 0);
+        }
+
+        memset(buf, 0x5a, ZEROING_ALLOC_SIZE);
+        bench_keep(buf);
+    }
+
+    double elapsed = bench_now() - start;
+    allocator_linear_free(arena);
+    return elapsed;
+}
+
+static void zeroing_run(const char* name, Allocator_Zero_Policy policy, bool no_zero) {
+    // A fresh mapping for each policy, so the first pass always sees memory zero-filled by the OS
+    void* buf = ALLOCATOR_BACKING_MMAP.alloc(NULL, ZEROING_BUF_LEN, 0);
+    assert(buf != NULL);
+
+    Allocator_Linear arena;
+    allocator_linear_init(&arena, buf, ZEROING_BUF_LEN);
+    allocator_linear_set_zero_policy(&arena, policy);
+
+    // The mapping is known to be zero-filled, ALLOCATOR_ZERO_LAZY can skip it on the first pass
+    arena.dirty_offset = 0;
+
+    double fresh  = zeroing_pass(&arena, no_zero);
+    double reused = 0.0;
+    for (size_t pass = 0; pass < ZEROING_PASSES; pass += 1) {
+        reused += zeroing_pass(&arena, no_zero);
+    }
+    reused /= ZEROING_PASSES;
+
+    // The zeroing policies must still hand out cleared memory once it has been dirtied
+    if (!no_zero && policy != ALLOCATOR_ZERO_NEVER) {
+        uint8_t* check = allocator_linear_alloc(&arena, ZEROING_ALLOC_SIZE);
+        for (size_t i = 0; i < ZEROING_ALLOC_SIZE; i += 1) {
+            assert(check[i] == 0);
+        }
+        allocator_linear_free(&arena);
+    }
+
+    double gib = (double) ZEROING_BUF_LEN / (1024.0 * 1024.0 * 1024.0);
+    printf("%-22s fresh: %7.2f ms (%5.2f GiB/s)   reused: %7.2f ms (%5.2f GiB/s)\n",
+        name, fresh * 1e3, gib / fresh, reused * 1e3, gib / reused);
+
+    ALLOCATOR_BACKING_MMAP.free(NULL, buf, ZEROING_BUF_LEN);
+}
+
+void bench_zeroing(void) {
+    printf("%d MiB of %d KiB allocations, each overwritten right away\n\n", ZEROING_BUF_LEN >> 20, ZEROING_ALLOC_SIZE >> 10);
+
+    zeroing_run("ALLOCATOR_ZERO_ALWAYS", ALLOCATOR_ZERO_ALWAYS, false);
+    zeroing_run("ALLOCATOR_ZERO_LAZY",   ALLOCATOR_ZERO_LAZY,   false);
+    zeroing_run("ALLOCATOR_ZERO_NEVER",  ALLOCATOR_ZERO_NEVER,  false);
+    zeroing_run("_no_zero",              ALLOCATOR_ZERO_ALWAYS, true);
+}
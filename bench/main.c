@@ -0,0 +1,83 @@
+#include <pthread.h>
+#include <string.h>
+
+#include "bench.h"
+
+typedef struct Bench {
+    const char* name;
+    void      (*run)(void);
+} Bench;
+
+static const Bench BENCHES[] = {
+    { "linear_virtual",  bench_linear_virtual  },
+    { "zeroing",         bench_zeroing         },
+    { "linear_atomic",   bench_linear_atomic   },
+    { "pool_bitmap",     bench_pool_bitmap     },
+    { "pool_concurrent", bench_pool_concurrent },
+    { "pool_batch",      bench_pool_batch      },
+    { "pool_slot_map",   bench_pool_slot_map   },
+    { "pool_sort",       bench_pool_sort       },
+    { "pool_align",      bench_pool_align      },
+    { "pool_coloring",   bench_pool_coloring   },
+    { "buddy",           bench_buddy           },
+    { "tlsf",            bench_tlsf            },
+    { "slab",            bench_slab            },
+};
+
+typedef struct Bench_Thread {
+    Bench_Thread_Fn    fn;
+    void*              user_data;
+    size_t             index;
+    pthread_barrier_t* barrier;
+} Bench_Thread;
+
+static void* bench_thread_main(void* arg) {
+    Bench_Thread* thread = (Bench_Thread*) arg;
+    pthread_barrier_wait(thread->barrier);
+    thread->fn(thread->index, thread->user_data);
+    return NULL;
+}
+
+double bench_run_threads(size_t thread_count, Bench_Thread_Fn fn, void* user_data) {
+    assert(thread_count > 0 && thread_count <= BENCH_MAX_THREADS);
+
+    pthread_t         handles[BENCH_MAX_THREADS];
+    Bench_Thread      threads[BENCH_MAX_THREADS];
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, (unsigned) thread_count + 1);
+
+    for (size_t i = 0; i < thread_count; i += 1) {
+        threads[i] = (Bench_Thread) { fn, user_data, i, &barrier };
+        int result = pthread_create(&handles[i], NULL, bench_thread_main, &threads[i]);
+        assert(result == 0);
+    }
+
+    pthread_barrier_wait(&barrier);
+    double start = bench_now();
+    for (size_t i = 0; i < thread_count; i += 1) {
+        pthread_join(handles[i], NULL);
+    }
+    double elapsed = bench_now() - start;
+
+    pthread_barrier_destroy(&barrier);
+    return elapsed;
+}
+
+/**
+ * Runs every benchmark, or only the ones named on the command line (e.g. `make bench-run ARGS=zeroing`).
+ */
+int main(int argc, char** argv) {
+    for (size_t i = 0; i < sizeof(BENCHES) / sizeof(BENCHES[0]); i += 1) {
+        bool selected = argc < 2;
+        for (int arg = 1; arg < argc; arg += 1) {
+            selected = selected || strcmp(argv[arg], BENCHES[i].name) == 0;
+        }
+
+        if (selected) {
+            printf("# %s\n\n", BENCHES[i].name);
+            BENCHES[i].run();
+            printf("\n");
+        }
+    }
+    return 0;
+}
@@ -1,8 +1,38 @@
 #ifndef ALLOCATORS_H
 #define ALLOCATORS_H
 
+#include <pthread.h>
+#include <stdatomic.h>
+
 #include "utils.h"
 
+/**
+ * How an allocator clears the memory it hands out.
+ *
+ * Zeroing every allocation doubles the memory bandwidth of allocations which are overwritten right 
+ * away (e.g. a multi-megabyte buffer filled by a read), this policy allows to opt out of it.
+ *
+ * Values:
+ * - `ALLOCATOR_ZERO_ALWAYS`:
+ *   Every allocation is cleared. This is the default of the allocators over a user-provided buffer.
+ * - `ALLOCATOR_ZERO_NEVER`:
+ *   Allocations are returned with whatever the buffer contains.
+ * - `ALLOCATOR_ZERO_LAZY`:
+ *   Allocations are zeroed, but the allocator tracks a "dirty" high-water mark (`dirty_offset`): 
+ *   the bytes past it were never handed out and are known to still be zero, so they are not 
+ *   cleared again. This is the default of the allocators owning memory fresh from the OS.
+ *
+ * ### Notes:
+ * - A user-provided buffer is considered dirty entirely. If it is known to be zero-filled 
+ *   (e.g. from `calloc` or `mmap`), set the allocator's `dirty_offset` to `0` after initialization.
+ * - The `_no_zero` allocation procedures never clear the memory, whatever the policy.
+ */
+typedef enum Allocator_Zero_Policy {
+    ALLOCATOR_ZERO_ALWAYS, // Every allocation is cleared
+    ALLOCATOR_ZERO_NEVER,  // Allocations are never cleared
+    ALLOCATOR_ZERO_LAZY,   // Only the bytes which were handed out before are cleared
+} Allocator_Zero_Policy;
+
 /**
  * A linear allocator, also known as an arena or region-based allocator, manages memory allocations
  * sequentially within a single continuous block of memory. Deallocation is performed in one step 
@@ -19,6 +49,10 @@
  *   Offset to the previous allocation, useful for resizing or reverting the last allocation.
  * - `size_t curr_offset`:
  *   Current offset within the buffer, marking the position for the next allocation.
+ * - `Allocator_Zero_Policy zero_policy`:
+ *   How the allocated memory is cleared, see `Allocator_Zero_Policy`.
+ * - `size_t dirty_offset`:
+ *   High-water mark of the memory handed out, the bytes past it are known to be zero (lazy zeroing).
  *
  * ### Key Characteristics:
  * - Memory is allocated sequentially, ensuring low overhead and fast allocation times.
@@ -31,6 +65,9 @@ typedef struct Allocator_Linear {
     size_t   buf_len;     // Total length of the backing buffer, in bytes
     size_t   prev_offset; // Offset to the previous allocation
     size_t   curr_offset; // Offset for the next allocation
+
+    Allocator_Zero_Policy zero_policy;  // How the allocated memory is cleared
+    size_t                dirty_offset; // Bytes past this offset were never handed out
 } Allocator_Linear;
 
 /**
@@ -49,9 +86,22 @@ typedef struct Allocator_Linear {
  * - Users can control the buffer's memory allocation source (e.g., stack for short-lived allocators 
  *   or heap for longer-lived allocators).
  * - Ensure that `backing_buf_len` is sufficient for the anticipated allocations to prevent buffer overflows.
+ * - The zeroing policy is `ALLOCATOR_ZERO_ALWAYS`, see `allocator_linear_set_zero_policy`.
  */
 void allocator_linear_init(Allocator_Linear* allocator, void* backing_buf, size_t backing_buf_len);
 
+/**
+ * Sets how a linear allocator clears the memory it hands out.
+ *
+ * @param allocator    Pointer to the `Allocator_Linear`.
+ * @param zero_policy  The new zeroing policy, see `Allocator_Zero_Policy`.
+ *
+ * ### Notes:
+ * - The policy applies to `allocator_linear_alloc_align`, `allocator_linear_alloc` and the bytes 
+ *   added by an in-place resize.
+ */
+void allocator_linear_set_zero_policy(Allocator_Linear* allocator, Allocator_Zero_Policy zero_policy);
+
 /**
  * Allocates memory from a linear allocator with the specified alignment.
  * Ensures that each new allocation adheres to the given alignment requirement
@@ -112,6 +162,23 @@ void* allocator_linear_alloc_align(Allocator_Linear* allocator, size_t data_size
  */
 void* allocator_linear_alloc(Allocator_Linear* allocator, size_t data_size);
 
+/**
+ * Allocates memory from a linear allocator with the specified alignment, without clearing it.
+ *
+ * Same as `allocator_linear_alloc_align`, but the memory is returned as-is whatever the zeroing 
+ * policy of the allocator. Use it for buffers which are entirely overwritten right away.
+ *
+ * @return A pointer to the uninitialized memory block, or NULL if allocation fails
+ *         due to insufficient space.
+ */
+void* allocator_linear_alloc_align_no_zero(Allocator_Linear* allocator, size_t data_size, size_t data_align);
+
+/**
+ * Allocates memory from a linear allocator with the default alignment, without clearing it.
+ * See `allocator_linear_alloc_align_no_zero`.
+ */
+void* allocator_linear_alloc_no_zero(Allocator_Linear* allocator, size_t data_size);
+
 /**
  * Resets the linear allocator, freeing all allocated memory.
  *
@@ -219,677 +286,3052 @@ void* allocator_linear_resize_align(Allocator_Linear* allocator, void* old_memor
  */
 void* allocator_linear_resize(Allocator_Linear* allocator, void* old_memory, size_t old_size, size_t new_size);
 
-// TODO: Allocator_Linear_Temp
-
 /**
- * Metadata for managing allocations in a stack-based allocator.
+ * A checkpoint of a linear allocator, used to free every allocation made after it at once.
  *
- * The `Allocator_Stack_Header` structure is used to store metadata about a specific 
- * allocation in the stack allocator. It helps manage the stack-like behavior of the allocator.
+ * `allocator_linear_temp_begin` saves the offsets of the allocator and `allocator_linear_temp_end` 
+ * restores them, both in O(1). This allows a single long-lived linear allocator to serve many 
+ * short-lived phases (scratch memory of a function, of a request, ...) without being reset entirely.
  *
  * Members:
- * - `prev_offset`: The offset within the buffer to the previous allocation. 
- *                  This allows the allocator to backtrack and free the last allocation.
- * - `padding`: The padding (in bytes) added before this header to ensure the alignment of the current allocation.
+ * - `allocator`: The linear allocator the checkpoint belongs to.
+ * - `prev_offset`: `prev_offset` of the allocator when the checkpoint was taken.
+ * - `curr_offset`: `curr_offset` of the allocator when the checkpoint was taken.
  *
  * ### Notes:
- * - This header is typically stored in memory just before the allocated data block it describes.
- * - The padding value ensures that subsequent allocations meet the alignment requirements.
+ * - Checkpoints can be nested, as long as they are ended in the reverse order they were begun.
+ * - With GCC and Clang, `ALLOCATOR_LINEAR_TEMP_SCOPE` ends the checkpoint automatically at the 
+ *   end of the enclosing scope.
+ *
+ * ### Example Usage:
+ * ```c
+ * Allocator_Linear_Temp temp = allocator_linear_temp_begin(&arena);
+ * void* scratch = allocator_linear_alloc(&arena, 4096);
+ * // ... use scratch ...
+ * allocator_linear_temp_end(&temp); // scratch is freed, earlier allocations are kept
+ * ```
  */
-typedef struct Allocator_Stack_Header {
-    size_t prev_offset; // Offset to the previous allocation
-    size_t padding;     // Padding of the previous allocation (in bytes), added before the header to have the new allocation aligned correctly.
-} Allocator_Stack_Header;
+typedef struct Allocator_Linear_Temp {
+    Allocator_Linear* allocator;   // Linear allocator the checkpoint belongs to
+    size_t            prev_offset; // Saved offset to the previous allocation
+    size_t            curr_offset; // Saved offset for the next allocation
+} Allocator_Linear_Temp;
 
 /**
- * A stack-based memory allocator for efficient, temporary memory management.
+ * Takes a checkpoint of a linear allocator.
  *
- * The `Allocator_Stack` struct implements a stack-like allocator, where memory is allocated and 
- * deallocated in a last-in, first-out (LIFO) order. This approach is more flexible than an linear/arena allocator, 
- * allowing individual deallocation of the most recent allocation without impacting earlier ones.
+ * @param allocator   Pointer to the `Allocator_Linear` to take the checkpoint of.
  *
- * Members:
- * - `buf`: Pointer to the backing buffer that provides the memory storage for allocations.
- * - `buf_len`: Total size of the backing buffer, in bytes.
- * - `prev_offset`: Offset to the most recently allocated block, allowing the allocator to track 
- *                  and backtrack allocations.
- * - `curr_offset`: Offset to the next available memory address in the buffer for new allocations.
+ * @return The checkpoint, to pass to `allocator_linear_temp_end`.
+ */
+Allocator_Linear_Temp allocator_linear_temp_begin(Allocator_Linear* allocator);
+
+/**
+ * Restores a linear allocator to a checkpoint, freeing every allocation made since it was taken.
  *
- * ### Behavior:
- * - **Allocation**: Memory is allocated sequentially from the buffer. The `curr_offset` is updated 
- *   to reflect the newly allocated memory block.
- * - **Deallocation**: Memory can be freed by reverting the `curr_offset` to the `prev_offset` of 
- *   the last allocation, effectively "popping" it off the stack.
- * - **Efficiency**: This allocator is efficient for temporary memory usage patterns that follow a 
- *   LIFO structure. However, it does not support random deallocation of older blocks.
+ * @param temp   Pointer to the checkpoint returned by `allocator_linear_temp_begin`. A checkpoint 
+ *               whose `allocator` is `NULL` is ignored.
  *
- * ### Notes:
- * - The stack allocator operates entirely within the bounds of the `buf` backing buffer.
- * - It is the user's responsibility to ensure that allocations fit within the remaining buffer space.
- * - The stack allocator does not reclaim memory for allocations that are not the most recent, adhering to its LIFO principle.
+ * ### Assertions:
+ * - Ensures the checkpoints are ended in the reverse order they were begun (an outer checkpoint 
+ *   ended before an inner one would leave the inner one pointing past the allocator's offset).
+ */
+void allocator_linear_temp_end(Allocator_Linear_Temp* temp);
+
+/**
+ * Declares a checkpoint named `name` of the linear allocator `allocator`, ended automatically 
+ * when the enclosing scope exits (including through `return`, `break` or `goto`).
  *
  * ### Example Usage:
  * ```c
- * Allocator_Stack stack;
- * allocator_stack_init(&stack, buffer, buffer_size);
- * 
- * void* mem1 = allocator_stack_alloc(&stack, 32); // Allocate 32 bytes with default alignment
- * void* mem2 = allocator_stack_alloc(&stack, 16); // Allocate 16 bytes with default alignment
- * 
- * allocator_stack_free(&stack, mem2); // Free the most recent allocation (mem2)
- * allocator_stack_free(&stack, mem1); // Free the next allocation (mem1)
+ * void handle_request(Allocator_Linear* arena) {
+ *     ALLOCATOR_LINEAR_TEMP_SCOPE(scratch, arena);
+ *     char* line = allocator_linear_alloc(arena, 1024);
+ *     // ...
+ * } // Everything allocated from `arena` in this function is freed here
  * ```
+ *
+ * ### Notes:
+ * - Relies on `__attribute__((cleanup))`, only available with GCC and Clang.
  */
-typedef struct Allocator_Stack {
-    uint8_t* buf;         // Pointer to the backing buffer
-    size_t   buf_len;     // Total length of the backing buffer, in bytes
-    size_t   prev_offset; // Offset to the previous allocation
-    size_t   curr_offset; // Offset to the next available allocation address
-} Allocator_Stack;
+#if defined(__GNUC__)
+#define ALLOCATOR_LINEAR_TEMP_SCOPE(name, allocator) \
+    Allocator_Linear_Temp name __attribute__((cleanup(allocator_linear_temp_end))) = allocator_linear_temp_begin(allocator)
+#endif
 
 /**
- * Initializes a stack-based allocator with a given backing buffer.
- *
- * This function sets up an `Allocator_Stack` structure to manage memory allocations
- * from a user-provided backing buffer. The backing buffer allows the user to control
- * where the memory is allocated (e.g., stack or heap) and its size.
+ * A source of large memory blocks for the allocators able to grow past their initial buffer.
  *
- * @param allocator       Pointer to the `Allocator_Stack` to initialize.
- * @param backing_buf     Pointer to the backing buffer used for allocations. Must not be `NULL`.
- * @param backing_buf_len The size of the backing buffer in bytes.
+ * The growable allocators never call `malloc` or `mmap` directly, they ask their `Allocator_Backing` 
+ * for new blocks instead. This keeps the choice of the underlying memory (heap, virtual memory, 
+ * a parent allocator, ...) to the user.
  *
- * ### Behavior:
- * - The `buf` pointer in the allocator is set to the provided `backing_buf`.
- * - The total buffer length is recorded in `buf_len`.
- * - Both `prev_offset` and `curr_offset` are initialized to `0`, indicating that 
- *   no memory has been allocated yet.
+ * Members:
+ * - `alloc`:
+ *   Returns a block of at least `size` bytes aligned to `align` (a power of two), or `NULL` on failure.
+ * - `free`:
+ *   Gives back a block previously returned by `alloc`, `size` being the size that was requested.
+ * - `user_data`:
+ *   Opaque pointer passed as-is to `alloc` and `free`.
+ * - `zero_filled`:
+ *   `true` if the blocks returned by `alloc` are always zero-filled, which the lazy zeroing policy 
+ *   takes advantage of.
  *
  * ### Notes:
- * - The provided `backing_buf` should be properly aligned for the intended usage. 
- *   Misaligned buffers may lead to undefined behavior.
- * - The user is responsible for ensuring that the `backing_buf` remains valid for 
- *   the lifetime of the allocator.
- * - This function does not allocate or manage the backing buffer itself; it simply 
- *   initializes the allocator to operate on the given memory.
+ * - `ALLOCATOR_BACKING_MALLOC` and `ALLOCATOR_BACKING_MMAP` are ready to use backing sources.
+ * - Blocks coming from `ALLOCATOR_BACKING_MMAP` are page aligned and zero-filled by the OS.
+ */
+typedef struct Allocator_Backing {
+    void* (*alloc)(void* user_data, size_t size, size_t align); // Requests a new block
+    void  (*free)(void* user_data, void* ptr, size_t size);     // Gives back a block
+    void* user_data;                                            // Passed to `alloc` and `free`
+    bool  zero_filled;                                          // Blocks are returned zero-filled
+} Allocator_Backing;
+
+/**
+ * Backing source using the C heap (`aligned_alloc` / `free`).
+ */
+extern const Allocator_Backing ALLOCATOR_BACKING_MALLOC;
+
+/**
+ * Backing source mapping anonymous pages straight from the OS (`mmap` / `VirtualAlloc`).
+ */
+extern const Allocator_Backing ALLOCATOR_BACKING_MMAP;
+
+/**
+ * Returns the size of a virtual memory page, in bytes.
+ */
+size_t allocator_os_page_size(void);
+
+/**
+ * Reserves `size` bytes of address space without backing them with physical memory.
+ * The range is inaccessible until committed with `allocator_os_commit`.
  *
- * ### Example Usage:
- * ```c
- * uint8_t buffer[1024]; // Backing buffer
- * Allocator_Stack stack;
- * 
- * allocator_stack_init(&stack, buffer, sizeof(buffer));
- * 
- * void* mem1 = allocator_stack_alloc_align(&stack, 64, 8); // Allocate 64 bytes with 8-byte alignment
- * ```
+ * @return The start of the reserved range (page aligned), or `NULL` on failure.
  */
-void allocator_stack_init(Allocator_Stack* allocator, void* backing_buf, size_t backing_buf_len);
+void* allocator_os_reserve(size_t size);
 
 /**
- * Allocates aligned memory from a stack-based allocator with header metadata.
+ * Makes a page aligned range of reserved memory readable and writable.
+ * Freshly committed pages read as zero.
  *
- * This function allocates memory from an `Allocator_Stack` instance while ensuring that 
- * the memory address is aligned to the specified alignment. Metadata about the allocation, 
- * such as the padding and the previous offset, is stored in the padding space before the 
- * allocated memory block.
+ * @return `true` on success, `false` if the OS refused to commit the range.
+ */
+bool allocator_os_commit(void* ptr, size_t size);
+
+/**
+ * Gives the physical pages of a committed range back to the OS and makes it inaccessible again.
+ * The address range stays reserved and can be committed again later.
+ */
+void allocator_os_decommit(void* ptr, size_t size);
+
+/**
+ * Gives the physical pages of a committed range back to the OS, but keeps the range accessible: 
+ * the pages are faulted in again on the next access. Their content is undefined after the call 
+ * (zero on Linux), so the caller must not rely on it.
+ */
+void allocator_os_purge(void* ptr, size_t size);
+
+/**
+ * Releases an address range returned by `allocator_os_reserve`.
+ */
+void allocator_os_release(void* ptr, size_t size);
+
+/**
+ * Growth factor applied to the block size each time a growable linear allocator chains a new block.
+ */
+#ifndef ALLOCATOR_LINEAR_GROWTH_FACTOR
+#define ALLOCATOR_LINEAR_GROWTH_FACTOR 2
+#endif
+
+/**
+ * Upper bound of the geometric growth of the blocks of a growable linear allocator, in bytes.
+ * Requests larger than this still get a block of their own, sized to fit.
+ */
+#ifndef ALLOCATOR_LINEAR_BLOCK_SIZE_MAX
+#define ALLOCATOR_LINEAR_BLOCK_SIZE_MAX ((size_t) 64 * 1024 * 1024)
+#endif
+
+/**
+ * Header stored at the start of each block chained by an `Allocator_Linear_Growable`.
  *
- * @param allocator   Pointer to the `Allocator_Stack` instance managing the memory.
- * @param data_size   The size of the memory block to allocate, in bytes.
- * @param align       The alignment requirement for the allocation, which must be a power of two.
- *                    If the alignment exceeds 128, it is capped at 128 due to padding constraints.
+ * Members:
+ * - `prev`: The block used before this one.
+ * - `next`: The block used after this one. After a free, the blocks following the first one are 
+ *           kept in the chain as a cache for the next allocations.
+ * - `size`: Total size of the block, header included, in bytes.
+ * - `dirty_offset`: Dirty high-water mark of the block, saved while the block is not the current one.
+ */
+typedef struct Allocator_Linear_Block {
+    struct Allocator_Linear_Block* prev; // Previous block in the chain
+    struct Allocator_Linear_Block* next; // Next block in the chain (in use or cached)
+    size_t                         size;         // Size of the block, header included, in bytes
+    size_t                         dirty_offset; // Bytes past this offset were never handed out
+} Allocator_Linear_Block;
+
+/**
+ * A linear allocator which chains new blocks when its current one is full instead of returning `NULL`.
  *
- * @return A pointer to the newly allocated and zero-initialized memory block, or `NULL` if 
- *         there is insufficient space in the buffer to accommodate the allocation.
+ * The allocator bump-allocates from the current block with a regular `Allocator_Linear`. When a request 
+ * does not fit, a new block is requested from the backing source and becomes the current one. Each new 
+ * block is `ALLOCATOR_LINEAR_GROWTH_FACTOR` times larger than the previous one (up to `block_size_max`), 
+ * so only a handful of blocks are needed whatever the peak usage is.
  *
- * ### Behavior:
- * - **Alignment**: Ensures the allocated memory address satisfies the specified alignment.
- *   - Uses `calc_padding_with_header` to calculate the required padding, considering alignment and header size.
- * - **Header Placement**: Stores metadata (`Allocator_Stack_Header`) within the padding area, just 
- *   before the aligned memory address.
- * - **Buffer Bounds**: If the allocation exceeds the available space in the buffer, the function 
- *   returns `NULL` without modifying the allocator state.
- * - **State Updates**: Updates the allocator's `curr_offset` and `prev_offset` to reflect the new allocation.
- * - **Zero Initialization**: The allocated memory block is zero-initialized for convenience.
+ * Members:
+ * - `linear`: Linear allocator over the usable part of the current block.
+ * - `first`: First block of the chain, `NULL` until the first allocation.
+ * - `block`: Block the allocations are currently served from.
+ * - `backing`: Source of the blocks.
+ * - `block_size`: Size of the next block to request, in bytes.
+ * - `block_size_max`: Upper bound of the geometric growth, in bytes.
+ * - `cached_block_count`: Number of blocks kept after the first one when the allocator is freed.
  *
- * ### Implementation Notes:
- * - The maximum supported alignment is 128 bytes due to the use of an 8-bit padding value in the header.
- * - The function ensures alignment is a power of two using an assertion (`assert(is_power_of_two(align))`).
- * - The allocation metadata (`padding` and `prev_offset`) enables efficient deallocation in a stack-like manner.
+ * ### Key Characteristics:
+ * - The allocation fast path is the one of `Allocator_Linear`, the growth only happens on the slow path.
+ * - Pointers are stable: growing never moves previous allocations, but two allocations are not 
+ *   guaranteed to be contiguous.
+ * - Freeing rewinds to the first block and keeps some blocks cached, so a steady-state workload 
+ *   does not request or release any memory from the backing source.
  *
- * ### Example:
+ * ### Example Usage:
  * ```c
- * uint8_t buffer[1024];
- * Allocator_Stack stack;
- * allocator_stack_init(&stack, buffer, sizeof(buffer));
- *
- * // Allocate 64 bytes with 16-byte alignment
- * void* block1 = allocator_stack_alloc_align(&stack, 64, 16);
- *
- * // Allocate 128 bytes with 32-byte alignment
- * void* block2 = allocator_stack_alloc_align(&stack, 128, 32);
+ * Allocator_Linear_Growable arena;
+ * allocator_linear_growable_init(&arena, ALLOCATOR_BACKING_MMAP, 64 * 1024, 4);
  *
- * if (!block1 || !block2) {
- *     printf("Allocation failed due to insufficient space.\n");
+ * for (;;) {
+ *     handle_request(&arena);                 // Any amount of allocations
+ *     allocator_linear_growable_free(&arena); // Rewind, keep up to 5 blocks around
  * }
+ *
+ * allocator_linear_growable_destroy(&arena);
  * ```
+ */
+typedef struct Allocator_Linear_Growable {
+    Allocator_Linear        linear;             // Linear allocator over the current block
+    Allocator_Linear_Block* first;              // First block of the chain
+    Allocator_Linear_Block* block;              // Current block
+    Allocator_Backing       backing;            // Source of the blocks
+    size_t                  block_size;         // Size of the next requested block, in bytes
+    size_t                  block_size_max;     // Upper bound of the geometric growth, in bytes
+    size_t                  cached_block_count; // Blocks kept after the first one on free
+} Allocator_Linear_Growable;
+
+/**
+ * Initializes a growable linear allocator.
  *
- * ### Error Handling:
- * - If the allocation exceeds the buffer size, the function returns `NULL` without modifying the allocator.
+ * No memory is requested at initialization, the first block is chained by the first allocation.
  *
- * ### Limitations:
- * - Alignments greater than 128 bytes are automatically capped at 128.
+ * @param allocator          Pointer to the `Allocator_Linear_Growable` to initialize.
+ * @param backing            Source of the blocks (e.g. `ALLOCATOR_BACKING_MMAP`).
+ * @param block_size         Size of the first block, in bytes, header included.
+ * @param cached_block_count Number of blocks kept after the first one by `allocator_linear_growable_free`.
+ *
+ * ### Notes:
+ * - `block_size_max` is set to `ALLOCATOR_LINEAR_BLOCK_SIZE_MAX` (or `block_size` if larger) and can be 
+ *   changed after initialization.
+ * - The zeroing policy is `ALLOCATOR_ZERO_LAZY`: blocks from a zero-filled backing source are only 
+ *   cleared where they were handed out before. It can be changed on the `linear` member.
+ * - The blocks are owned by the allocator, call `allocator_linear_growable_destroy` to release them.
  */
-void* allocator_stack_alloc_align(Allocator_Stack* allocator, size_t data_size, size_t align);
+void allocator_linear_growable_init(Allocator_Linear_Growable* allocator, Allocator_Backing backing, size_t block_size, size_t cached_block_count);
 
 /**
- * Allocates memory from a stack-based allocator with default alignment.
+ * Allocates memory from a growable linear allocator with the specified alignment.
  *
- * This function is a convenience wrapper around `allocator_stack_alloc_align`. It allocates 
- * memory of the specified size (`data_size`) from the `Allocator_Stack` using the default alignment.
- *
- * @param allocator   Pointer to the `Allocator_Stack` instance managing the memory.
- * @param data_size   The size of the memory block to allocate, in bytes.
+ * The memory is taken from the current block like `allocator_linear_alloc_align` does. If it does not 
+ * fit, the allocator moves to the next cached block when it is large enough, or chains a new block 
+ * sized for the request otherwise. The unused tail of the previous block is left as is.
  *
- * @return A pointer to the newly allocated and zero-initialized memory block, or `NULL` if 
- *         there is insufficient space in the buffer to accommodate the allocation.
+ * @param allocator   Pointer to the `Allocator_Linear_Growable`.
+ * @param data_size   Size of the data to allocate, in bytes.
+ * @param data_align  Alignment requirement, in bytes. Must be a power of two.
  *
- * ### Behavior:
- * - Uses the default alignment (`DEFAULT_ALIGNMENT`) for the allocation.
- * - Delegates the allocation logic to `allocator_stack_alloc_align`, ensuring that alignment and 
- *   memory constraints are properly handled.
- * - Returns a pointer to the allocated memory block, which is zero-initialized for convenience.
+ * @return A pointer to the zero-initialized memory, or `NULL` only if the backing source failed.
+ */
+void* allocator_linear_growable_alloc_align(Allocator_Linear_Growable* allocator, size_t data_size, size_t data_align);
+
+/**
+ * Allocates memory from a growable linear allocator with the default alignment.
+ * See `allocator_linear_growable_alloc_align`.
+ */
+void* allocator_linear_growable_alloc(Allocator_Linear_Growable* allocator, size_t data_size);
+
+/**
+ * Resets a growable linear allocator, freeing all allocated memory.
  *
- * ### Example:
- * ```c
- * uint8_t buffer[1024];
- * Allocator_Stack stack;
- * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ * The allocator rewinds to its first block. Up to `cached_block_count` blocks following it are kept 
+ * for the next allocations, the other ones are given back to the backing source.
  *
- * // Allocate 64 bytes using the default alignment
- * void* block = allocator_stack_alloc(&stack, 64);
+ * @param allocator   Pointer to the `Allocator_Linear_Growable` to reset.
+ */
+void allocator_linear_growable_free(Allocator_Linear_Growable* allocator);
+
+/**
+ * Gives every block of a growable linear allocator back to the backing source.
+ * The allocator can be used again afterward, it will chain a new first block.
  *
- * if (!block) {
- *     printf("Allocation failed due to insufficient space.\n");
- * }
- * ```
+ * @param allocator   Pointer to the `Allocator_Linear_Growable` to destroy.
+ */
+void allocator_linear_growable_destroy(Allocator_Linear_Growable* allocator);
+
+/**
+ * Resizes a previously allocated memory block of a growable linear allocator, with specified alignment.
  *
- * ### Error Handling:
- * - If the allocation exceeds the buffer size or alignment requirements cannot be met, 
- *   the function returns `NULL` without modifying the allocator.
+ * ### Behavior:
+ * - If `old_memory` is `NULL` or `old_size` is `0`, a new block is allocated.
+ * - If `old_memory` is the last allocation of the current block and the block has enough room left, 
+ *   the resize is done in place (see `allocator_linear_resize_align`).
+ * - Otherwise a new block is allocated, possibly in a new block of the chain, and the data is copied.
  *
- * ### Notes:
- * - This function simplifies memory allocation when specific alignment is not required.
- * - The default alignment is defined by the `DEFAULT_ALIGNMENT` macro. */
-void* allocator_stack_alloc(Allocator_Stack* allocator, size_t data_size);
+ * @return A pointer to the resized memory block, or `NULL` if the backing source failed.
+ */
+void* allocator_linear_growable_resize_align(Allocator_Linear_Growable* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align);
 
 /**
- * Frees memory previously allocated from a stack-based allocator.
+ * Resizes a previously allocated memory block of a growable linear allocator, using the default alignment.
+ * See `allocator_linear_growable_resize_align`.
+ */
+void* allocator_linear_growable_resize(Allocator_Linear_Growable* allocator, void* old_memory, size_t old_size, size_t new_size);
+
+/**
+ * A linear allocator over a large range of reserved virtual memory, committed on demand.
  *
- * This function deallocates memory from an `Allocator_Stack` instance. It ensures that memory 
- * is freed in a last-in, first-out (LIFO) order, maintaining the integrity of the stack-based 
- * allocation system. The function also performs boundary and order checks to catch improper usage.
+ * The whole address range (e.g. 64 GiB) is reserved once at initialization without any physical 
+ * memory behind it. Pages are then committed by granules of `commit_granule` bytes as `curr_offset` 
+ * crosses them, so the resident memory follows the actual usage while the allocations stay in a 
+ * single contiguous range.
  *
- * @param allocator   Pointer to the `Allocator_Stack` instance managing the memory.
- * @param ptr         Pointer to the memory block to free. If `NULL`, the function does nothing.
+ * Members:
+ * - `linear`: Linear allocator over the reserved range. `linear.buf_len` is the committed length, 
+ *             allocating past it commits more memory.
+ * - `reserve_len`: Size of the reserved address range, in bytes.
+ * - `commit_granule`: Amount of memory committed at once, in bytes (a multiple of the page size).
  *
- * ### Behavior:
- * - **Null Pointer Handling**: If `ptr` is `NULL`, the function exits without any action.
- * - **Bounds Check**: Ensures the `ptr` lies within the valid range of the stack allocator's buffer.
- *   - If the address is out of bounds, the function asserts with an error message and exits.
- * - **Double Free Check**: Prevents freeing memory that is beyond the current offset, effectively 
- *   allowing "double frees" without altering the allocator state.
- * - **Order Check**: Verifies that memory is freed in LIFO order. If an out-of-order free is detected, 
- *   the function asserts with an error message and exits.
- * - **State Updates**: Adjusts the allocator's `curr_offset` and `prev_offset` to reflect the deallocation.
- *
- * ### Preconditions:
- * - The pointer `ptr` must have been allocated by the same `Allocator_Stack` instance.
- * - Memory must be freed in reverse order of allocation (LIFO principle).
- *
- * ### Error Handling:
- * - **Out of Bounds**: If `ptr` is outside the allocator's buffer range, the function asserts 
- *   with the message: `"Out of bounds memory address passed to stack allocator (free)"`.
- * - **Out of Order Free**: If memory is not freed in the correct LIFO order, the function asserts 
- *   with the message: `"Out of order stack allocator free"`.
+ * ### Key Characteristics:
+ * - Pointers are stable and contiguous, the buffer never moves.
+ * - `allocator_linear_virtual_resize_align` can always grow the last allocation in place.
+ * - The committed memory comes zero-filled from the OS, the zeroing policy is `ALLOCATOR_ZERO_LAZY` 
+ *   so it is only cleared again once it was handed out.
  *
- * ### Example:
+ * ### Example Usage:
  * ```c
- * uint8_t buffer[1024];
- * Allocator_Stack stack;
- * allocator_stack_init(&stack, buffer, sizeof(buffer));
- *
- * // Allocate memory
- * void* block1 = allocator_stack_alloc(&stack, 64);
- * void* block2 = allocator_stack_alloc(&stack, 128);
+ * Allocator_Linear_Virtual arena;
+ * allocator_linear_virtual_init(&arena, (size_t) 64 << 30, 64 * 1024); // 64 GiB reserved
  *
- * // Free memory in reverse order of allocation
- * allocator_stack_free(&stack, block2);
- * allocator_stack_free(&stack, block1);
+ * void* mem = allocator_linear_virtual_alloc(&arena, 1024);
+ * mem = allocator_linear_virtual_resize(&arena, mem, 1024, 1 << 20);    // Grows in place
  *
- * // Improper free (out of order) will trigger an assertion
- * // allocator_stack_free(&stack, block1); // Uncommenting will assert
+ * allocator_linear_virtual_free(&arena, 1 << 20);                       // Keep 1 MiB committed
+ * allocator_linear_virtual_destroy(&arena);
  * ```
+ */
+typedef struct Allocator_Linear_Virtual {
+    Allocator_Linear linear;         // Linear allocator over the committed part of the range
+    size_t           reserve_len;    // Size of the reserved address range, in bytes
+    size_t           commit_granule; // Amount of memory committed at once, in bytes
+} Allocator_Linear_Virtual;
+
+/**
+ * Reserves the address range of a virtual linear allocator.
+ *
+ * @param allocator      Pointer to the `Allocator_Linear_Virtual` to initialize.
+ * @param reserve_size   Size of the address range to reserve, in bytes. Rounded up to `commit_granule`.
+ * @param commit_granule Amount of memory committed at once, in bytes. Must be a power of two, 
+ *                       values smaller than a page are raised to the page size.
+ *
+ * @return `true` on success, `false` if the OS refused the reservation.
  *
  * ### Notes:
- * - This function enforces the stack-like allocation order by verifying the `prev_offset` stored 
- *   in the `Allocator_Stack_Header` against the calculated offset.
- * - It is designed to detect and prevent misuse, such as out-of-bounds or out-of-order freeing.
+ * - Only address space is reserved, no memory is committed until the first allocation.
+ * - The range is owned by the allocator, call `allocator_linear_virtual_destroy` to release it.
+ */
+bool allocator_linear_virtual_init(Allocator_Linear_Virtual* allocator, size_t reserve_size, size_t commit_granule);
+
+/**
+ * Releases the address range of a virtual linear allocator. All allocations become invalid.
+ */
+void allocator_linear_virtual_destroy(Allocator_Linear_Virtual* allocator);
+
+/**
+ * Allocates memory from a virtual linear allocator with the specified alignment.
  *
- * ### Limitations:
- * - Only supports stack-based allocation patterns (LIFO). Any other freeing order results in an error.
+ * Behaves like `allocator_linear_alloc_align`. When the committed memory is not enough, the granules 
+ * crossed by the allocation are committed first.
+ *
+ * @return A pointer to the zero-initialized memory, or `NULL` if the reserved range is exhausted 
+ *         or the OS refused to commit more memory.
  */
-void allocator_stack_free(Allocator_Stack* allocator, void* ptr);
+void* allocator_linear_virtual_alloc_align(Allocator_Linear_Virtual* allocator, size_t data_size, size_t data_align);
 
 /**
- * Frees all memory allocated by the stack-based allocator.
+ * Allocates memory from a virtual linear allocator with the default alignment.
+ * See `allocator_linear_virtual_alloc_align`.
+ */
+void* allocator_linear_virtual_alloc(Allocator_Linear_Virtual* allocator, size_t data_size);
+
+/**
+ * Resets a virtual linear allocator, freeing all allocated memory.
  *
- * This function resets the `Allocator_Stack` to its initial state, effectively marking all 
- * memory in the buffer as free. It does not modify the contents of the buffer, but subsequent 
- * allocations will overwrite the previously allocated data.
+ * The memory committed above `keep_committed` (rounded up to the commit granule) is decommitted 
+ * and its pages given back to the OS (`MADV_DONTNEED` on POSIX systems). Pass `SIZE_MAX` to keep 
+ * everything committed, or `0` to give everything back. Decommitted pages come back zero-filled, 
+ * the dirty high-water mark is lowered accordingly.
  *
- * @param allocator   Pointer to the `Allocator_Stack` instance to reset.
+ * @param allocator       Pointer to the `Allocator_Linear_Virtual` to reset.
+ * @param keep_committed  High-water mark, in bytes, under which the memory stays committed.
+ */
+void allocator_linear_virtual_free(Allocator_Linear_Virtual* allocator, size_t keep_committed);
+
+/**
+ * Resizes a previously allocated memory block of a virtual linear allocator, with specified alignment.
  *
  * ### Behavior:
- * - Sets both `prev_offset` and `curr_offset` to `0`, resetting the allocator's state.
- * - Does not perform any deallocation of the underlying buffer, as it is managed externally.
- * - All pointers to previously allocated memory become invalid after this operation.
+ * - If `old_memory` is `NULL` or `old_size` is `0`, a new block is allocated.
+ * - If `old_memory` is the last allocation, it is always resized in place, committing more 
+ *   memory if needed. `NULL` is only returned when the reserved range is exhausted.
+ * - Otherwise a new block is allocated and the data is copied.
+ */
+void* allocator_linear_virtual_resize_align(Allocator_Linear_Virtual* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align);
+
+/**
+ * Resizes a previously allocated memory block of a virtual linear allocator, using the default alignment.
+ * See `allocator_linear_virtual_resize_align`.
+ */
+void* allocator_linear_virtual_resize(Allocator_Linear_Virtual* allocator, void* old_memory, size_t old_size, size_t new_size);
+
+/**
+ * A linear allocator which can be shared by several threads without a lock.
  *
- * ### Example:
- * ```c
- * uint8_t buffer[1024];
- * Allocator_Stack stack;
- * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ * The offset for the next allocation is advanced atomically: with a single `fetch_add` for the 
+ * allocations using at most the default alignment, with a compare-and-swap loop for the more 
+ * aligned ones (the padding depends on the offset actually taken).
  *
- * // Allocate memory
- * void* block1 = allocator_stack_alloc(&stack, 64);
- * void* block2 = allocator_stack_alloc(&stack, 128);
+ * Members:
+ * - `buf`: Pointer to the backing buffer, aligned to `DEFAULT_ALIGNEMENT`.
+ * - `buf_len`: Usable length of the backing buffer, in bytes.
+ * - `curr_offset`: Offset for the next allocation, always a multiple of `DEFAULT_ALIGNEMENT`. 
+ *                  It can go past `buf_len` once the buffer is exhausted.
+ * - `epoch`: Number of times the allocator was reset, used by the `Allocator_Linear_Tlab` taking 
+ *            slices from it to notice their slice is no longer theirs.
  *
- * // Reset the stack allocator
- * allocator_stack_free_all(&stack);
+ * ### Notes:
+ * - Allocation sizes are rounded up to `DEFAULT_ALIGNEMENT`.
+ * - Resetting the allocator with `allocator_linear_atomic_free` must not race with allocations.
+ * - There is no resize: the last allocation of the buffer is not known to any single thread.
  *
- * // After resetting, all previous allocations are invalid
- * // Any new allocation will start from the beginning of the buffer
- * void* new_block = allocator_stack_alloc(&stack, 256);
+ * ### Example Usage:
+ * ```c
+ * Allocator_Linear_Atomic batch_arena;
+ * allocator_linear_atomic_init(&batch_arena, buffer, buffer_len);
+ *
+ * // From any number of threads:
+ * Record* record = allocator_linear_atomic_alloc(&batch_arena, sizeof(Record));
+ *
+ * // Once every worker is done with the batch:
+ * allocator_linear_atomic_free(&batch_arena);
  * ```
+ */
+typedef struct Allocator_Linear_Atomic {
+    uint8_t*       buf;         // Pointer to the backing buffer
+    size_t         buf_len;     // Usable length of the backing buffer, in bytes
+    _Atomic size_t curr_offset; // Offset for the next allocation
+    _Atomic size_t epoch;       // Incremented each time the allocator is reset
+} Allocator_Linear_Atomic;
+
+/**
+ * Initializes a thread-safe linear allocator with a specified backing buffer.
+ *
+ * @param allocator       Pointer to the `Allocator_Linear_Atomic` to initialize.
+ * @param backing_buf     Pointer to the memory buffer that the allocator will manage.
+ * @param backing_buf_len Size of the backing buffer, in bytes.
  *
  * ### Notes:
- * - Use this function to quickly free all allocated memory when it is no longer needed, without 
- *   having to free individual allocations in reverse order.
- * - This operation is non-destructive to the buffer's contents but invalidates all previous 
- *   allocations.
- * - Suitable for scenarios where the entire buffer's memory can be reclaimed at once.
+ * - The start of the buffer is aligned forward to `DEFAULT_ALIGNEMENT`.
+ * - Initialization itself is not thread-safe, the allocator must be published to the other threads afterward.
+ */
+void allocator_linear_atomic_init(Allocator_Linear_Atomic* allocator, void* backing_buf, size_t backing_buf_len);
+
+/**
+ * Allocates zero-initialized memory from a thread-safe linear allocator with the specified alignment.
  *
- * ### Limitations:
- * - Does not provide any checks or warnings for invalidating existing pointers; the user is 
- *   responsible for ensuring that pointers to previous allocations are no longer used.
+ * @param allocator   Pointer to the shared `Allocator_Linear_Atomic`.
+ * @param data_size   Size of the data to allocate, in bytes.
+ * @param data_align  Alignment requirement, in bytes. Must be a power of two.
+ *
+ * @return A pointer to the allocated memory, or `NULL` if the buffer is exhausted. A failed 
+ *         allocation never hands out memory past the end of the buffer.
+ *
+ * ### Notes:
+ * - Lock-free. Wait-free when `data_align` is at most `DEFAULT_ALIGNEMENT`.
+ * - When several threads race for the last bytes of the buffer, the losers' reservations push 
+ *   the offset past the end: every following allocation fails until the allocator is reset.
  */
-void allocator_stack_free_all(Allocator_Stack* allocator);
+void* allocator_linear_atomic_alloc_align(Allocator_Linear_Atomic* allocator, size_t data_size, size_t data_align);
 
 /**
- * Resizes an allocated block in the stack-based allocator with alignment.
+ * Allocates zero-initialized memory from a thread-safe linear allocator with the default alignment.
+ * See `allocator_linear_atomic_alloc_align`.
+ */
+void* allocator_linear_atomic_alloc(Allocator_Linear_Atomic* allocator, size_t data_size);
+
+/**
+ * Allocates memory from a thread-safe linear allocator with the specified alignment, without clearing it.
+ * See `allocator_linear_atomic_alloc_align`.
+ */
+void* allocator_linear_atomic_alloc_align_no_zero(Allocator_Linear_Atomic* allocator, size_t data_size, size_t data_align);
+
+/**
+ * Allocates memory from a thread-safe linear allocator with the default alignment, without clearing it.
+ * See `allocator_linear_atomic_alloc_align`.
+ */
+void* allocator_linear_atomic_alloc_no_zero(Allocator_Linear_Atomic* allocator, size_t data_size);
+
+/**
+ * Resets a thread-safe linear allocator, freeing all allocated memory.
  *
- * This function attempts to resize a memory block managed by the stack allocator. If the block 
- * is the most recent allocation, the resize operation is performed in place. Otherwise, a new 
- * block is allocated, and the existing data is copied over. The memory block can also be freed 
- * by passing a `new_data_size` of `0`.
+ * ### Notes:
+ * - Must not be called while other threads are allocating, e.g. once all the workers of a batch joined.
+ * - The epoch is incremented, so the `Allocator_Linear_Tlab` allocating from this allocator drop 
+ *   their current slice on their next allocation. Resetting the whole arena stays O(1).
+ */
+void allocator_linear_atomic_free(Allocator_Linear_Atomic* allocator);
+
+/**
+ * A thread-local allocation buffer (TLAB): a per-thread linear allocator over slices of a shared 
+ * `Allocator_Linear_Atomic`.
  *
- * @param allocator       Pointer to the `Allocator_Stack` instance managing the memory.
- * @param ptr             Pointer to the existing memory block to resize. Can be `NULL`.
- * @param old_data_size   The current size of the memory block (in bytes).
- * @param new_data_size   The desired new size of the memory block (in bytes).
- * @param align           Alignment of the memory block. Must be a power of two.
- * 
- * @return
- * - Pointer to the resized memory block.
- * - If the block is resized in place, the same pointer is returned.
- * - If the block is moved, a new pointer is returned with the resized data.
- * - Returns `NULL` if the memory block is freed or if the resize operation fails.
+ * Each thread owns its `Allocator_Linear_Tlab`. It reserves a large slice of the shared arena with 
+ * a single atomic operation, then bump-allocates from it with the plain `Allocator_Linear` logic, 
+ * without any atomic read-modify-write. When the slice runs out, a new one is taken. This is the 
+ * scheme used by the JVM to allocate at near single-threaded speed on every core.
  *
- * ### Behavior:
- * 1. **Null Pointer Case**:
- *    - If `ptr` is `NULL`, a new block of size `new_data_size` is allocated with the given alignment.
- * 2. **In-Place Resize**:
- *    - If `ptr` points to the most recently allocated block, the block is resized in place.
- *    - If the block grows, the new memory is zero-initialized.
- * 3. **Free Memory**:
- *    - If `new_data_size` is `0`, the block is freed, and `NULL` is returned.
- * 4. **Relocation**:
- *    - If the block is not the most recent allocation, a new block is allocated.
- *    - The existing data (up to the minimum of the old and new sizes) is copied to the new block.
- * 5. **Bounds Check**:
- *    - Ensures the pointer lies within the buffer's bounds. An out-of-bounds pointer triggers an 
- *      assertion failure.
- *    - Prevents double-free scenarios by validating the pointer against the current allocation state.
+ * Members:
+ * - `linear`: Linear allocator over the current slice.
+ * - `shared`: The arena the slices are taken from.
+ * - `slice_size`: Size of the slices taken from the shared arena, in bytes.
+ * - `epoch`: Epoch of the shared arena when the current slice was taken.
  *
- * ### Example:
+ * ### Key Characteristics:
+ * - Requests larger than half a slice are served by the shared arena directly.
+ * - Resetting the shared arena with `allocator_linear_atomic_free` resets every TLAB at once: 
+ *   a TLAB whose epoch is outdated takes a new slice on its next allocation.
+ * - The unused tail of a slice is lost until the shared arena is reset.
+ *
+ * ### Example Usage:
  * ```c
- * uint8_t buffer[1024];
- * Allocator_Stack stack;
- * allocator_stack_init(&stack, buffer, sizeof(buffer));
- * 
- * // Allocate memory
- * void* block = allocator_stack_alloc_align(&stack, 64, 16);
- * 
- * // Resize the block to a larger size
- * block = allocator_stack_resize_align(&stack, block, 64, 128, 16);
- * 
- * // Resize the block to a smaller size
- * block = allocator_stack_resize_align(&stack, block, 128, 32, 16);
- * 
- * // Free the block
- * allocator_stack_resize_align(&stack, block, 32, 0, 16);
+ * static Allocator_Linear_Atomic batch_arena; // Shared
+ * static _Thread_local Allocator_Linear_Tlab tlab;
+ *
+ * // In each worker:
+ * allocator_linear_tlab_init(&tlab, &batch_arena, 256 * 1024);
+ * Record* record = allocator_linear_tlab_alloc(&tlab, sizeof(Record));
  * ```
+ */
+typedef struct Allocator_Linear_Tlab {
+    Allocator_Linear         linear;     // Linear allocator over the current slice
+    Allocator_Linear_Atomic* shared;     // Arena the slices are taken from
+    size_t                   slice_size; // Size of the slices, in bytes
+    size_t                   epoch;      // Epoch of the shared arena when the slice was taken
+} Allocator_Linear_Tlab;
+
+/**
+ * Initializes a thread-local allocation buffer over a shared thread-safe linear allocator.
+ *
+ * @param allocator   Pointer to the `Allocator_Linear_Tlab` to initialize, owned by the calling thread.
+ * @param shared      Pointer to the shared `Allocator_Linear_Atomic` to take the slices from.
+ * @param slice_size  Size of the slices to take, in bytes. Rounded up to `DEFAULT_ALIGNEMENT`.
  *
  * ### Notes:
- * - This function is most efficient when resizing the most recent allocation in the stack.
- * - For non-recent allocations, a new memory block is allocated, and the original data is copied, 
- *   which incurs additional overhead.
- * - If `align` is greater than `128`, it will be clamped to `128` due to internal padding limits.
+ * - No slice is taken at initialization, the first allocation takes one.
+ */
+void allocator_linear_tlab_init(Allocator_Linear_Tlab* allocator, Allocator_Linear_Atomic* shared, size_t slice_size);
+
+/**
+ * Allocates zero-initialized memory from a thread-local allocation buffer with the specified alignment.
  *
- * ### Assertions:
- * - The `align` parameter must be a power of two.
- * - Ensures the pointer is within the bounds of the allocator's buffer.
+ * @param allocator   Pointer to the `Allocator_Linear_Tlab` of the calling thread.
+ * @param data_size   Size of the data to allocate, in bytes.
+ * @param data_align  Alignment requirement, in bytes. Must be a power of two.
  *
- * ### Limitations:
- * - Resizing non-recent allocations requires a full copy of the data, which may be inefficient for 
- *   large allocations.
- * - Does not provide guarantees for performance in scenarios with frequent non-recent resizes.
+ * @return A pointer to the allocated memory, or `NULL` if the shared arena is exhausted.
+ *
+ * ### Notes:
+ * - The fast path is a relaxed load of the shared epoch and an `allocator_linear_alloc_align`.
+ * - The zeroing policy of the `linear` member applies to the allocations served from the slice.
  */
-void* allocator_stack_resize_align(Allocator_Stack* allocator, void* ptr, size_t old_data_size, size_t new_data_size, size_t align);
+void* allocator_linear_tlab_alloc_align(Allocator_Linear_Tlab* allocator, size_t data_size, size_t data_align);
 
 /**
- * Resizes an allocated block in the stack-based allocator with default alignment.
+ * Allocates zero-initialized memory from a thread-local allocation buffer with the default alignment.
+ * See `allocator_linear_tlab_alloc_align`.
+ */
+void* allocator_linear_tlab_alloc(Allocator_Linear_Tlab* allocator, size_t data_size);
+
+/**
+ * Number of scratch arenas of each thread, see `allocator_scratch_get`.
+ * Two are enough as long as at most one arena is passed as a conflict.
+ */
+#ifndef ALLOCATOR_SCRATCH_COUNT
+#define ALLOCATOR_SCRATCH_COUNT 2
+#endif
+
+/**
+ * Size of each scratch arena, in bytes. The arenas are mapped from the OS, the pages are only 
+ * backed by physical memory once they are used.
+ */
+#ifndef ALLOCATOR_SCRATCH_SIZE
+#define ALLOCATOR_SCRATCH_SIZE ((size_t) 64 * 1024 * 1024)
+#endif
+
+/**
+ * Returns a checkpoint of one of the scratch arenas of the calling thread, different from every 
+ * arena listed in `conflicts`.
  *
- * This function resizes a memory block managed by the stack allocator, using the default alignment. 
- * If the block is the most recent allocation, the resize operation is performed in place. Otherwise, 
- * a new block is allocated, and the existing data is copied over. Passing a `new_data_size` of `0` 
- * frees the memory block.
+ * Each thread lazily gets `ALLOCATOR_SCRATCH_COUNT` linear allocators of `ALLOCATOR_SCRATCH_SIZE` 
+ * bytes, released at thread exit. A function needing temporary memory takes a scratch arena, 
+ * allocates from it and ends the checkpoint before returning. When the function also has to return 
+ * a result allocated from an arena given by its caller, that arena is passed as a conflict: the 
+ * scratch arena is then guaranteed to be another one, so freeing the temporaries cannot free the 
+ * result even if the caller's arena is itself a scratch arena.
  *
- * @param allocator       Pointer to the `Allocator_Stack` instance managing the memory.
- * @param ptr             Pointer to the existing memory block to resize. Can be `NULL`.
- * @param old_data_size   The current size of the memory block (in bytes).
- * @param new_data_size   The desired new size of the memory block (in bytes).
- * 
- * @return
- * - Pointer to the resized memory block.
- * - If the block is resized in place, the same pointer is returned.
- * - If the block is moved, a new pointer is returned with the resized data.
- * - Returns `NULL` if the memory block is freed or if the resize operation fails.
+ * @param conflicts       Arenas the scratch arena must not be, can be `NULL` if `conflict_count` is `0`.
+ * @param conflict_count  Number of arenas in `conflicts`.
  *
- * ### Behavior:
- * 1. **Null Pointer Case**:
- *    - If `ptr` is `NULL`, a new block of size `new_data_size` is allocated with the default alignment.
- * 2. **In-Place Resize**:
- *    - If `ptr` points to the most recently allocated block, the block is resized in place.
- *    - If the block grows, the new memory is zero-initialized.
- * 3. **Free Memory**:
- *    - If `new_data_size` is `0`, the block is freed, and `NULL` is returned.
- * 4. **Relocation**:
- *    - If the block is not the most recent allocation, a new block is allocated.
- *    - The existing data (up to the minimum of the old and new sizes) is copied to the new block.
+ * @return A checkpoint of the scratch arena (`temp.allocator`), to end with `allocator_linear_temp_end`.
+ *         `temp.allocator` is `NULL` if the arenas could not be created.
  *
- * ### Example:
+ * ### Example Usage:
  * ```c
- * uint8_t buffer[1024];
- * Allocator_Stack stack;
- * allocator_stack_init(&stack, buffer, sizeof(buffer));
- * 
- * // Allocate memory
- * void* block = allocator_stack_alloc(&stack, 64);
- * 
- * // Resize the block to a larger size
- * block = allocator_stack_resize(&stack, block, 64, 128);
- * 
- * // Resize the block to a smaller size
- * block = allocator_stack_resize(&stack, block, 128, 32);
- * 
- * // Free the block
- * allocator_stack_resize(&stack, block, 32, 0);
+ * char* join_paths(Allocator_Linear* result_arena, const char** paths, size_t count) {
+ *     Allocator_Linear_Temp scratch = allocator_scratch_get(&result_arena, 1);
+ *     char** normalized = allocator_linear_alloc(scratch.allocator, count * sizeof(char*));
+ *     // ... temporaries in scratch.allocator, the result in result_arena ...
+ *     allocator_linear_temp_end(&scratch);
+ *     return result;
+ * }
  * ```
  *
  * ### Notes:
- * - This function wraps `allocator_stack_resize_align` and uses the default alignment.
- * - It is most efficient when resizing the most recent allocation in the stack.
- * - For non-recent allocations, a new memory block is allocated, and the original data is copied, 
- *   which incurs additional overhead.
+ * - The scratch arenas use the `ALLOCATOR_ZERO_LAZY` policy.
+ * - The arenas are freed through a `pthread` key destructor when the thread exits. Key destructors 
+ *   do not run for the main thread returning from `main`, nor for a thread ending with `exit`: such a 
+ *   thread calls `allocator_scratch_release` itself at shutdown.
+ */
+Allocator_Linear_Temp allocator_scratch_get(Allocator_Linear* const* conflicts, size_t conflict_count);
+
+/**
+ * Frees the scratch arenas of the calling thread, e.g. at the end of `main` or before a long idle 
+ * period. No-op if the thread has none.
+ *
+ * ### Notes:
+ * - No checkpoint of the arenas may still be in use. A later `allocator_scratch_get` creates new arenas.
+ */
+void allocator_scratch_release(void);
+
+/**
+ * Declares a scratch checkpoint named `name`, ended automatically when the enclosing scope exits.
+ * See `allocator_scratch_get` and `ALLOCATOR_LINEAR_TEMP_SCOPE`.
+ */
+#if defined(__GNUC__)
+#define ALLOCATOR_SCRATCH_SCOPE(name, conflicts, conflict_count) \
+    Allocator_Linear_Temp name __attribute__((cleanup(allocator_linear_temp_end))) = allocator_scratch_get(conflicts, conflict_count)
+#endif
+
+/**
+ * Metadata for managing allocations in a stack-based allocator.
+ *
+ * The `Allocator_Stack_Header` structure is used to store metadata about a specific 
+ * allocation in the stack allocator. It helps manage the stack-like behavior of the allocator.
+ *
+ * Members:
+ * - `prev_offset`: The offset within the buffer to the previous allocation. 
+ *                  This allows the allocator to backtrack and free the last allocation.
+ * - `padding`: The padding (in bytes) added before this header to ensure the alignment of the current allocation.
+ *
+ * ### Notes:
+ * - This header is typically stored in memory just before the allocated data block it describes.
+ * - The padding value ensures that subsequent allocations meet the alignment requirements.
+ */
+typedef struct Allocator_Stack_Header {
+    size_t prev_offset; // Offset to the previous allocation
+    size_t padding;     // Padding of the previous allocation (in bytes), added before the header to have the new allocation aligned correctly.
+} Allocator_Stack_Header;
+
+/**
+ * A stack-based memory allocator for efficient, temporary memory management.
+ *
+ * The `Allocator_Stack` struct implements a stack-like allocator, where memory is allocated and 
+ * deallocated in a last-in, first-out (LIFO) order. This approach is more flexible than an linear/arena allocator, 
+ * allowing individual deallocation of the most recent allocation without impacting earlier ones.
+ *
+ * Members:
+ * - `buf`: Pointer to the backing buffer that provides the memory storage for allocations.
+ * - `buf_len`: Total size of the backing buffer, in bytes.
+ * - `prev_offset`: Offset to the most recently allocated block, allowing the allocator to track 
+ *                  and backtrack allocations.
+ * - `curr_offset`: Offset to the next available memory address in the buffer for new allocations.
+ * - `zero_policy`: How the allocated memory is cleared, see `Allocator_Zero_Policy`.
+ * - `dirty_offset`: High-water mark of the memory handed out, the bytes past it are known to be zero.
+ *
+ * ### Behavior:
+ * - **Allocation**: Memory is allocated sequentially from the buffer. The `curr_offset` is updated 
+ *   to reflect the newly allocated memory block.
+ * - **Deallocation**: Memory can be freed by reverting the `curr_offset` to the `prev_offset` of 
+ *   the last allocation, effectively "popping" it off the stack.
+ * - **Efficiency**: This allocator is efficient for temporary memory usage patterns that follow a 
+ *   LIFO structure. However, it does not support random deallocation of older blocks.
+ *
+ * ### Notes:
+ * - The stack allocator operates entirely within the bounds of the `buf` backing buffer.
+ * - It is the user's responsibility to ensure that allocations fit within the remaining buffer space.
+ * - The stack allocator does not reclaim memory for allocations that are not the most recent, adhering to its LIFO principle.
+ *
+ * ### Example Usage:
+ * ```c
+ * Allocator_Stack stack;
+ * allocator_stack_init(&stack, buffer, buffer_size);
+ * 
+ * void* mem1 = allocator_stack_alloc(&stack, 32); // Allocate 32 bytes with default alignment
+ * void* mem2 = allocator_stack_alloc(&stack, 16); // Allocate 16 bytes with default alignment
+ * 
+ * allocator_stack_free(&stack, mem2); // Free the most recent allocation (mem2)
+ * allocator_stack_free(&stack, mem1); // Free the next allocation (mem1)
+ * ```
+ */
+typedef struct Allocator_Stack {
+    uint8_t* buf;         // Pointer to the backing buffer
+    size_t   buf_len;     // Total length of the backing buffer, in bytes
+    size_t   prev_offset; // Offset to the previous allocation
+    size_t   curr_offset; // Offset to the next available allocation address
+
+    Allocator_Zero_Policy zero_policy;  // How the allocated memory is cleared
+    size_t                dirty_offset; // Bytes past this offset were never handed out
+} Allocator_Stack;
+
+/**
+ * Initializes a stack-based allocator with a given backing buffer.
+ *
+ * This function sets up an `Allocator_Stack` structure to manage memory allocations
+ * from a user-provided backing buffer. The backing buffer allows the user to control
+ * where the memory is allocated (e.g., stack or heap) and its size.
+ *
+ * @param allocator       Pointer to the `Allocator_Stack` to initialize.
+ * @param backing_buf     Pointer to the backing buffer used for allocations. Must not be `NULL`.
+ * @param backing_buf_len The size of the backing buffer in bytes.
+ *
+ * ### Behavior:
+ * - The `buf` pointer in the allocator is set to the provided `backing_buf`.
+ * - The total buffer length is recorded in `buf_len`.
+ * - Both `prev_offset` and `curr_offset` are initialized to `0`, indicating that 
+ *   no memory has been allocated yet.
+ *
+ * ### Notes:
+ * - The provided `backing_buf` should be properly aligned for the intended usage. 
+ *   Misaligned buffers may lead to undefined behavior.
+ * - The user is responsible for ensuring that the `backing_buf` remains valid for 
+ *   the lifetime of the allocator.
+ * - This function does not allocate or manage the backing buffer itself; it simply 
+ *   initializes the allocator to operate on the given memory.
+ *
+ * ### Example Usage:
+ * ```c
+ * uint8_t buffer[1024]; // Backing buffer
+ * Allocator_Stack stack;
+ * 
+ * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ * 
+ * void* mem1 = allocator_stack_alloc_align(&stack, 64, 8); // Allocate 64 bytes with 8-byte alignment
+ * ```
+ */
+void allocator_stack_init(Allocator_Stack* allocator, void* backing_buf, size_t backing_buf_len);
+
+/**
+ * Sets how a stack allocator clears the memory it hands out.
+ *
+ * @param allocator    Pointer to the `Allocator_Stack`.
+ * @param zero_policy  The new zeroing policy, see `Allocator_Zero_Policy`.
+ *
+ * ### Notes:
+ * - The default policy set by `allocator_stack_init` is `ALLOCATOR_ZERO_ALWAYS`.
+ */
+void allocator_stack_set_zero_policy(Allocator_Stack* allocator, Allocator_Zero_Policy zero_policy);
+
+/**
+ * Allocates aligned memory from a stack-based allocator with header metadata.
+ *
+ * This function allocates memory from an `Allocator_Stack` instance while ensuring that 
+ * the memory address is aligned to the specified alignment. Metadata about the allocation, 
+ * such as the padding and the previous offset, is stored in the padding space before the 
+ * allocated memory block.
+ *
+ * @param allocator   Pointer to the `Allocator_Stack` instance managing the memory.
+ * @param data_size   The size of the memory block to allocate, in bytes.
+ * @param align       The alignment requirement for the allocation, which must be a power of two.
+ *                    If the alignment exceeds 128, it is capped at 128 due to padding constraints.
+ *
+ * @return A pointer to the newly allocated and zero-initialized memory block, or `NULL` if 
+ *         there is insufficient space in the buffer to accommodate the allocation.
+ *
+ * ### Behavior:
+ * - **Alignment**: Ensures the allocated memory address satisfies the specified alignment.
+ *   - Uses `calc_padding_with_header` to calculate the required padding, considering alignment and header size.
+ * - **Header Placement**: Stores metadata (`Allocator_Stack_Header`) within the padding area, just 
+ *   before the aligned memory address.
+ * - **Buffer Bounds**: If the allocation exceeds the available space in the buffer, the function 
+ *   returns `NULL` without modifying the allocator state.
+ * - **State Updates**: Updates the allocator's `curr_offset` and `prev_offset` to reflect the new allocation.
+ * - **Zero Initialization**: The allocated memory block is zero-initialized for convenience.
+ *
+ * ### Implementation Notes:
+ * - The maximum supported alignment is 128 bytes due to the use of an 8-bit padding value in the header.
+ * - The function ensures alignment is a power of two using an assertion (`assert(is_power_of_two(align))`).
+ * - The allocation metadata (`padding` and `prev_offset`) enables efficient deallocation in a stack-like manner.
+ *
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Stack stack;
+ * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ *
+ * // Allocate 64 bytes with 16-byte alignment
+ * void* block1 = allocator_stack_alloc_align(&stack, 64, 16);
+ *
+ * // Allocate 128 bytes with 32-byte alignment
+ * void* block2 = allocator_stack_alloc_align(&stack, 128, 32);
+ *
+ * if (!block1 || !block2) {
+ *     printf("Allocation failed due to insufficient space.\n");
+ * }
+ * ```
+ *
+ * ### Error Handling:
+ * - If the allocation exceeds the buffer size, the function returns `NULL` without modifying the allocator.
+ *
+ * ### Limitations:
+ * - Alignments greater than 128 bytes are automatically capped at 128.
+ */
+void* allocator_stack_alloc_align(Allocator_Stack* allocator, size_t data_size, size_t align);
+
+/**
+ * Allocates memory from a stack-based allocator with default alignment.
+ *
+ * This function is a convenience wrapper around `allocator_stack_alloc_align`. It allocates 
+ * memory of the specified size (`data_size`) from the `Allocator_Stack` using the default alignment.
+ *
+ * @param allocator   Pointer to the `Allocator_Stack` instance managing the memory.
+ * @param data_size   The size of the memory block to allocate, in bytes.
+ *
+ * @return A pointer to the newly allocated and zero-initialized memory block, or `NULL` if 
+ *         there is insufficient space in the buffer to accommodate the allocation.
+ *
+ * ### Behavior:
+ * - Uses the default alignment (`DEFAULT_ALIGNMENT`) for the allocation.
+ * - Delegates the allocation logic to `allocator_stack_alloc_align`, ensuring that alignment and 
+ *   memory constraints are properly handled.
+ * - Returns a pointer to the allocated memory block, which is zero-initialized for convenience.
+ *
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Stack stack;
+ * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ *
+ * // Allocate 64 bytes using the default alignment
+ * void* block = allocator_stack_alloc(&stack, 64);
+ *
+ * if (!block) {
+ *     printf("Allocation failed due to insufficient space.\n");
+ * }
+ * ```
+ *
+ * ### Error Handling:
+ * - If the allocation exceeds the buffer size or alignment requirements cannot be met, 
+ *   the function returns `NULL` without modifying the allocator.
+ *
+ * ### Notes:
+ * - This function simplifies memory allocation when specific alignment is not required.
+ * - The default alignment is defined by the `DEFAULT_ALIGNMENT` macro. */
+void* allocator_stack_alloc(Allocator_Stack* allocator, size_t data_size);
+
+/**
+ * Allocates aligned memory from a stack-based allocator, without clearing it.
+ *
+ * Same as `allocator_stack_alloc_align`, but the memory is returned as-is whatever the zeroing 
+ * policy of the allocator. Use it for buffers which are entirely overwritten right away.
+ *
+ * @return A pointer to the uninitialized memory block, or `NULL` if there is insufficient space.
+ */
+void* allocator_stack_alloc_align_no_zero(Allocator_Stack* allocator, size_t data_size, size_t align);
+
+/**
+ * Allocates memory from a stack-based allocator with default alignment, without clearing it.
+ * See `allocator_stack_alloc_align_no_zero`.
+ */
+void* allocator_stack_alloc_no_zero(Allocator_Stack* allocator, size_t data_size);
+
+/**
+ * Frees memory previously allocated from a stack-based allocator.
+ *
+ * This function deallocates memory from an `Allocator_Stack` instance. It ensures that memory 
+ * is freed in a last-in, first-out (LIFO) order, maintaining the integrity of the stack-based 
+ * allocation system. The function also performs boundary and order checks to catch improper usage.
+ *
+ * @param allocator   Pointer to the `Allocator_Stack` instance managing the memory.
+ * @param ptr         Pointer to the memory block to free. If `NULL`, the function does nothing.
+ *
+ * ### Behavior:
+ * - **Null Pointer Handling**: If `ptr` is `NULL`, the function exits without any action.
+ * - **Bounds Check**: Ensures the `ptr` lies within the valid range of the stack allocator's buffer.
+ *   - If the address is out of bounds, the function asserts with an error message and exits.
+ * - **Double Free Check**: Prevents freeing memory that is beyond the current offset, effectively 
+ *   allowing "double frees" without altering the allocator state.
+ * - **Order Check**: Verifies that memory is freed in LIFO order. If an out-of-order free is detected, 
+ *   the function asserts with an error message and exits.
+ * - **State Updates**: Adjusts the allocator's `curr_offset` and `prev_offset` to reflect the deallocation.
+ *
+ * ### Preconditions:
+ * - The pointer `ptr` must have been allocated by the same `Allocator_Stack` instance.
+ * - Memory must be freed in reverse order of allocation (LIFO principle).
+ *
+ * ### Error Handling:
+ * - **Out of Bounds**: If `ptr` is outside the allocator's buffer range, the function asserts 
+ *   with the message: `"Out of bounds memory address passed to stack allocator (free)"`.
+ * - **Out of Order Free**: If memory is not freed in the correct LIFO order, the function asserts 
+ *   with the message: `"Out of order stack allocator free"`.
+ *
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Stack stack;
+ * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ *
+ * // Allocate memory
+ * void* block1 = allocator_stack_alloc(&stack, 64);
+ * void* block2 = allocator_stack_alloc(&stack, 128);
+ *
+ * // Free memory in reverse order of allocation
+ * allocator_stack_free(&stack, block2);
+ * allocator_stack_free(&stack, block1);
+ *
+ * // Improper free (out of order) will trigger an assertion
+ * // allocator_stack_free(&stack, block1); // Uncommenting will assert
+ * ```
+ *
+ * ### Notes:
+ * - This function enforces the stack-like allocation order by verifying the `prev_offset` stored 
+ *   in the `Allocator_Stack_Header` against the calculated offset.
+ * - It is designed to detect and prevent misuse, such as out-of-bounds or out-of-order freeing.
+ *
+ * ### Limitations:
+ * - Only supports stack-based allocation patterns (LIFO). Any other freeing order results in an error.
+ */
+void allocator_stack_free(Allocator_Stack* allocator, void* ptr);
+
+/**
+ * Frees all memory allocated by the stack-based allocator.
+ *
+ * This function resets the `Allocator_Stack` to its initial state, effectively marking all 
+ * memory in the buffer as free. It does not modify the contents of the buffer, but subsequent 
+ * allocations will overwrite the previously allocated data.
+ *
+ * @param allocator   Pointer to the `Allocator_Stack` instance to reset.
+ *
+ * ### Behavior:
+ * - Sets both `prev_offset` and `curr_offset` to `0`, resetting the allocator's state.
+ * - Does not perform any deallocation of the underlying buffer, as it is managed externally.
+ * - All pointers to previously allocated memory become invalid after this operation.
+ *
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Stack stack;
+ * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ *
+ * // Allocate memory
+ * void* block1 = allocator_stack_alloc(&stack, 64);
+ * void* block2 = allocator_stack_alloc(&stack, 128);
+ *
+ * // Reset the stack allocator
+ * allocator_stack_free_all(&stack);
+ *
+ * // After resetting, all previous allocations are invalid
+ * // Any new allocation will start from the beginning of the buffer
+ * void* new_block = allocator_stack_alloc(&stack, 256);
+ * ```
+ *
+ * ### Notes:
+ * - Use this function to quickly free all allocated memory when it is no longer needed, without 
+ *   having to free individual allocations in reverse order.
+ * - This operation is non-destructive to the buffer's contents but invalidates all previous 
+ *   allocations.
+ * - Suitable for scenarios where the entire buffer's memory can be reclaimed at once.
+ *
+ * ### Limitations:
+ * - Does not provide any checks or warnings for invalidating existing pointers; the user is 
+ *   responsible for ensuring that pointers to previous allocations are no longer used.
+ */
+void allocator_stack_free_all(Allocator_Stack* allocator);
+
+/**
+ * Resizes an allocated block in the stack-based allocator with alignment.
+ *
+ * This function attempts to resize a memory block managed by the stack allocator. If the block 
+ * is the most recent allocation, the resize operation is performed in place. Otherwise, a new 
+ * block is allocated, and the existing data is copied over. The memory block can also be freed 
+ * by passing a `new_data_size` of `0`.
+ *
+ * @param allocator       Pointer to the `Allocator_Stack` instance managing the memory.
+ * @param ptr             Pointer to the existing memory block to resize. Can be `NULL`.
+ * @param old_data_size   The current size of the memory block (in bytes).
+ * @param new_data_size   The desired new size of the memory block (in bytes).
+ * @param align           Alignment of the memory block. Must be a power of two.
+ * 
+ * @return
+ * - Pointer to the resized memory block.
+ * - If the block is resized in place, the same pointer is returned.
+ * - If the block is moved, a new pointer is returned with the resized data.
+ * - Returns `NULL` if the memory block is freed or if the resize operation fails.
+ *
+ * ### Behavior:
+ * 1. **Null Pointer Case**:
+ *    - If `ptr` is `NULL`, a new block of size `new_data_size` is allocated with the given alignment.
+ * 2. **In-Place Resize**:
+ *    - If `ptr` points to the most recently allocated block, the block is resized in place.
+ *    - If the block grows, the new memory is zero-initialized.
+ * 3. **Free Memory**:
+ *    - If `new_data_size` is `0`, the block is freed, and `NULL` is returned.
+ * 4. **Relocation**:
+ *    - If the block is not the most recent allocation, a new block is allocated.
+ *    - The existing data (up to the minimum of the old and new sizes) is copied to the new block.
+ * 5. **Bounds Check**:
+ *    - Ensures the pointer lies within the buffer's bounds. An out-of-bounds pointer triggers an 
+ *      assertion failure.
+ *    - Prevents double-free scenarios by validating the pointer against the current allocation state.
+ *
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Stack stack;
+ * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ * 
+ * // Allocate memory
+ * void* block = allocator_stack_alloc_align(&stack, 64, 16);
+ * 
+ * // Resize the block to a larger size
+ * block = allocator_stack_resize_align(&stack, block, 64, 128, 16);
+ * 
+ * // Resize the block to a smaller size
+ * block = allocator_stack_resize_align(&stack, block, 128, 32, 16);
+ * 
+ * // Free the block
+ * allocator_stack_resize_align(&stack, block, 32, 0, 16);
+ * ```
+ *
+ * ### Notes:
+ * - This function is most efficient when resizing the most recent allocation in the stack.
+ * - For non-recent allocations, a new memory block is allocated, and the original data is copied, 
+ *   which incurs additional overhead.
+ * - If `align` is greater than `128`, it will be clamped to `128` due to internal padding limits.
+ *
+ * ### Assertions:
+ * - The `align` parameter must be a power of two.
+ * - Ensures the pointer is within the bounds of the allocator's buffer.
+ *
+ * ### Limitations:
+ * - Resizing non-recent allocations requires a full copy of the data, which may be inefficient for 
+ *   large allocations.
+ * - Does not provide guarantees for performance in scenarios with frequent non-recent resizes.
+ */
+void* allocator_stack_resize_align(Allocator_Stack* allocator, void* ptr, size_t old_data_size, size_t new_data_size, size_t align);
+
+/**
+ * Resizes an allocated block in the stack-based allocator with default alignment.
+ *
+ * This function resizes a memory block managed by the stack allocator, using the default alignment. 
+ * If the block is the most recent allocation, the resize operation is performed in place. Otherwise, 
+ * a new block is allocated, and the existing data is copied over. Passing a `new_data_size` of `0` 
+ * frees the memory block.
+ *
+ * @param allocator       Pointer to the `Allocator_Stack` instance managing the memory.
+ * @param ptr             Pointer to the existing memory block to resize. Can be `NULL`.
+ * @param old_data_size   The current size of the memory block (in bytes).
+ * @param new_data_size   The desired new size of the memory block (in bytes).
+ * 
+ * @return
+ * - Pointer to the resized memory block.
+ * - If the block is resized in place, the same pointer is returned.
+ * - If the block is moved, a new pointer is returned with the resized data.
+ * - Returns `NULL` if the memory block is freed or if the resize operation fails.
+ *
+ * ### Behavior:
+ * 1. **Null Pointer Case**:
+ *    - If `ptr` is `NULL`, a new block of size `new_data_size` is allocated with the default alignment.
+ * 2. **In-Place Resize**:
+ *    - If `ptr` points to the most recently allocated block, the block is resized in place.
+ *    - If the block grows, the new memory is zero-initialized.
+ * 3. **Free Memory**:
+ *    - If `new_data_size` is `0`, the block is freed, and `NULL` is returned.
+ * 4. **Relocation**:
+ *    - If the block is not the most recent allocation, a new block is allocated.
+ *    - The existing data (up to the minimum of the old and new sizes) is copied to the new block.
+ *
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Stack stack;
+ * allocator_stack_init(&stack, buffer, sizeof(buffer));
+ * 
+ * // Allocate memory
+ * void* block = allocator_stack_alloc(&stack, 64);
+ * 
+ * // Resize the block to a larger size
+ * block = allocator_stack_resize(&stack, block, 64, 128);
+ * 
+ * // Resize the block to a smaller size
+ * block = allocator_stack_resize(&stack, block, 128, 32);
+ * 
+ * // Free the block
+ * allocator_stack_resize(&stack, block, 32, 0);
+ * ```
+ *
+ * ### Notes:
+ * - This function wraps `allocator_stack_resize_align` and uses the default alignment.
+ * - It is most efficient when resizing the most recent allocation in the stack.
+ * - For non-recent allocations, a new memory block is allocated, and the original data is copied, 
+ *   which incurs additional overhead.
+ *
+ * ### Limitations:
+ * - Resizing non-recent allocations requires a full copy of the data, which may be inefficient for 
+ *   large allocations.
+ * - Does not allow control over alignment. For custom alignment, use `allocator_stack_resize_align`.
+ */
+void* allocator_stack_resize(Allocator_Stack* allocator, void* ptr, size_t old_data_size, size_t new_data_size);
+
+/**
+ * @struct Allocator_Pool_Free_Node
+ * Represents a node in the free list of a pool allocator.
+ * 
+ * Each node corresponds to a free chunk of memory in the pool allocator.
+ * These nodes form a linked list, where each node points to the next free chunk.
+ *
+ * @member next Pointer to the next free chunk in the pool.
+ */
+typedef struct Allocator_Pool_Free_Node Allocator_Pool_Free_Node;
+struct Allocator_Pool_Free_Node {
+    Allocator_Pool_Free_Node *next; // Pointer to the next free chuck in the allocator.
+};
+
+/**
+ * @struct Allocator_Pool
+ * A pool-based memory allocator (sometimes called block allocator) that manages fixed-size chunks of memory.
+ *
+ * The pool allocator divides a supplied backing buffer into equal-sized chunks
+ * and maintains a free list to keep track of available chunks. Allocations are
+ * performed by removing a chunk from the free list, and deallocations are
+ * performed by adding a chunk back to the free list.
+ *
+ * ### Key Features:
+ * - **Constant Time Operations (O(1))**:
+ *   Allocations and deallocations are highly efficient, as they simply
+ *   involve updating pointers in the free list.
+ * - **Minimized Fragmentation**:
+ *   Since all chunks are of equal size, there is no internal fragmentation.
+ * - **Batch Allocation**:
+ *   Useful for allocating and deallocating groups of objects that share
+ *   the same size and often the same lifetime.
+ *
+ * ### Use Cases:
+ * - Managing dynamic objects of uniform size, such as game entities or network packets.
+ * - Scenarios where high allocation and deallocation performance is critical.
+ * 
+ * @member buf             Pointer to the backing buffer used for the pool.
+ * @member buf_len         Total size of the backing buffer, in bytes.
+ * @member chunk_size      Size of each chunk in the pool, in bytes.
+ * @member free_list_head  Pointer to the head of the free list, which tracks
+ *                         available chunks in the pool.
+ * @member unused_offset   Offset of the first chunk never handed out since the last reset. The chunks 
+ *                         from this offset are not on the free list (lazy mode only).
+ * @member lazy            Whether the free list is built lazily, see `allocator_pool_init_lazy`.
+ * @member live_bits       Occupancy bitmap with one bit per chunk, set while the chunk is allocated. 
+ *                         `NULL` unless the pool was initialized with `allocator_pool_init_tracked`.
+ *
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Pool pool;
+ * allocator_pool_init(&pool, buffer, sizeof(buffer), 64);
+ *
+ * void* chunk1 = allocator_pool_alloc(&pool);
+ * void* chunk2 = allocator_pool_alloc(&pool);
+ *
+ * allocator_pool_free(&pool, chunk1);
+ * allocator_pool_free(&pool, chunk2);
+ * ```
+ *
+ * ### Notes:
+ * - The chunk size must be greater than or equal to the size of `Allocator_Pool_Free_Node`.
+ * - The pool allocator is ideal for fixed-size allocations but is not suitable for variable-sized allocations.
+ */
+typedef struct Allocator_Pool {
+    uint8_t* buf;
+    size_t   buf_len;
+    size_t   chunk_size;
+
+    Allocator_Pool_Free_Node* free_list_head; // the free list, behaves like LinkedList.
+    size_t                    unused_offset;  // Chunks from this offset were never handed out
+    bool                      lazy;           // Chunks are bump-allocated from `unused_offset` before the free list is built
+    uint64_t*                 live_bits;      // Occupancy of the chunks, NULL when not tracked
+} Allocator_Pool;
+
+/**
+ * @brief Initializes a pool allocator with the given backing buffer, chunk size, and alignment.
+ * 
+ * The function sets up a pool allocator that divides the backing buffer into fixed-size chunks 
+ * aligned to the specified alignment. The allocator maintains a free list to track available 
+ * chunks and prepares the pool for allocations.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool` structure to initialize.
+ * - **backing_buf**: A pointer to the memory block to be used as the backing buffer.
+ * - **backing_buf_len**: The total size of the backing buffer in bytes.
+ * - **chunk_size**: The size of each chunk in bytes. This is aligned to the specified alignment.
+ * - **chunk_align**: The alignment for each chunk. Must be a power of two.
+ * 
+ * ### Behavior:
+ * 1. The backing buffer is aligned to the specified chunk alignment, and any excess bytes at the 
+ *    start are excluded from use.
+ * 2. The chunk size is aligned to the specified alignment to ensure proper spacing and alignment 
+ *    of chunks within the buffer.
+ * 3. Assertions verify that the chunk size is at least as large as the size of a free list node 
+ *    (`Allocator_Pool_Free_Node`) and that the backing buffer is large enough to hold at least 
+ *    one chunk.
+ * 4. The free list is initialized to include all chunks within the adjusted backing buffer.
+ * 
+ * ### Example:
+ * ```c
+ * uint8_t buffer[1024];
+ * Allocator_Pool pool;
+ * allocator_pool_init(&pool, buffer, sizeof(buffer), 64, 16);
+ *
+ * void* chunk1 = allocator_pool_alloc(&pool);
+ * void* chunk2 = allocator_pool_alloc(&pool);
+ *
+ * allocator_pool_free(&pool, chunk1);
+ * allocator_pool_free(&pool, chunk2);
+ * ```
+ * 
+ * ### High Alignment:
+ * Every chunk starts at a multiple of `chunk_align`, and is `chunk_size` rounded up to it. This makes 
+ * pools of padded objects a supported mode:
+ * - `chunk_align = ALLOCATOR_CACHE_LINE_SIZE`: each chunk owns whole cache lines, so per-core counters 
+ *   or per-thread states updated concurrently never share a line (no false sharing).
+ * - `chunk_align = 4096` or `2 * 1024 * 1024`: page or huge page sized I/O buffers (e.g. `O_DIRECT`). 
+ *   Take the backing buffer from `ALLOCATOR_BACKING_MMAP` with the same alignment, instead of losing 
+ *   up to `chunk_align - 1` bytes at the start of the buffer.
+ * 
+ * ```c
+ * size_t len = 64 * 2 * 1024 * 1024;
+ * void*  buf = ALLOCATOR_BACKING_MMAP.alloc(NULL, len, 2 * 1024 * 1024);
+ * allocator_pool_init_lazy(&pool, buf, len, 2 * 1024 * 1024, 2 * 1024 * 1024);
+ * ```
+ * 
+ * ### Notes:
+ * - The alignment must be a power of two to ensure correct behavior.
+ * - The `chunk_size` must be greater than or equal to the size of `Allocator_Pool_Free_Node`, 
+ *   as the free list nodes are stored within chunks.
+ * - The `allocator_pool_free_all` function is called at the end of initialization to reset 
+ *   and populate the free list.
+ * - `buf` is the aligned start of the backing buffer, which is the first chunk.
+ * 
+ * ### Assertions:
+ * - Ensures `chunk_align` is a power of two.
+ * - Ensures `chunk_size` is large enough to store a free list node.
+ * - Ensures the backing buffer is large enough to hold at least one aligned chunk.
+ */
+void allocator_pool_init(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t size_chunk_align);
+
+/**
+ * @brief Initializes a pool allocator whose free list is built lazily.
+ * 
+ * Same parameters and assertions as `allocator_pool_init`, but no chunk is written at initialization. 
+ * The pool keeps an "unused watermark" (`unused_offset`): chunks are bump-allocated from it while 
+ * the free list is empty, and only the chunks which were actually freed go on the free list.
+ * 
+ * ### Behavior:
+ * 1. `allocator_pool_alloc` takes the head of the free list, or the chunk at the watermark if the list is empty.
+ * 2. `allocator_pool_free` pushes the chunk on the free list, as in the eager mode.
+ * 3. `allocator_pool_free_all` empties the free list and moves the watermark back to the start.
+ * 
+ * ### Notes:
+ * - Initialization and reset are O(1): a multi-GB pool does not touch (nor fault in) any page 
+ *   until its chunks are allocated.
+ * - Fresh chunks are handed out in ascending address order.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1) for initialization, allocation, free and reset.
+ */
+void allocator_pool_init_lazy(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align);
+
+/**
+ * @brief Initializes a lazy pool allocator which keeps track of its live chunks, to iterate over them.
+ * 
+ * Same parameters as `allocator_pool_init_lazy`. An occupancy bitmap (one bit per chunk) is stored at 
+ * the start of the backing buffer, before the chunks. The bits are updated by every allocation and 
+ * free, and `allocator_pool_next_live` walks them to visit the live chunks in address order, which 
+ * replaces an external array of pointers to the live objects.
+ * 
+ * ### Notes:
+ * - Freeing a chunk which is already free is detected and asserts in this mode.
+ * - The iteration is a sequential scan over the chunks, skipping 64 free chunks at a time, and stops 
+ *   at the unused watermark: only the part of the pool which was ever used is visited.
+ * 
+ * ### Assertions:
+ * - Ensures the backing buffer is large enough to hold the bitmap and at least one aligned chunk.
+ */
+void allocator_pool_init_tracked(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align);
+
+/**
+ * @brief Allocates a chunk of memory from the pool allocator.
+ * 
+ * This function provides memory by returning a pointer to a free chunk in the pool. It removes 
+ * the chunk from the free list and returns a zero-initialized pointer to the chunk.
+ * If there are no available chunks in the pool, the function triggers an assertion and returns `NULL`.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool` structure from which to allocate memory.
+ * 
+ * ### Return:
+ * - **void***: A pointer to the allocated chunk of memory, or `NULL` if no free chunks are available.
+ * 
+ * ### Behavior:
+ * 1. The function checks the `free_list_head` to see if there are any free chunks available.
+ * 2. If no chunks are available (i.e., the free list is empty), it triggers an assertion to indicate 
+ *    that the pool is out of memory.
+ * 3. If a free chunk is available, the `free_list_head` is updated to point to the next chunk in the 
+ *    free list, and the allocated chunk is zero-initialized using `memset`.
+ * 
+ * ### Example:
+ * ```c
+ * Allocator_Pool pool;
+ * allocator_pool_init(&pool, buffer, 1024, 64, 16);
+ * 
+ * void* chunk = allocator_pool_alloc(&pool);
+ * if (chunk != NULL) {
+ *     // Use the allocated chunk...
+ * }
+ * ```
+ * 
+ * ### Notes:
+ * - The function assumes that the pool has been properly initialized using `allocator_pool_init`.
+ * - The chunk returned is zero-initialized, ensuring that all allocated memory starts with a clean state.
+ * - If the pool runs out of free chunks, the function will assert with an error message.
+ * 
+ * ### Assertions:
+ * - Ensures that there is at least one free chunk in the pool before allocation.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1), constant time allocation, as chunks are allocated from the free list.
+ * - **Space Complexity**: O(1), no additional space is used for allocation other than the chunk.
+ */
+void* allocator_pool_alloc(Allocator_Pool* allocator);
+
+/**
+ * @brief Checks whether a pool allocator still has a chunk to hand out.
+ * 
+ * Allows the callers which must not trigger the exhaustion assertion of `allocator_pool_alloc` 
+ * (e.g. layers caching chunks in batches) to stop before it.
+ * 
+ * ### Return:
+ * - **bool**: `true` if the next `allocator_pool_alloc` succeeds.
+ */
+bool allocator_pool_has_free_chunk(const Allocator_Pool* allocator);
+
+/**
+ * @brief Allocates up to `n` zero-initialized chunks from the pool allocator at once.
+ * 
+ * A burst of allocations (e.g. one chunk per message of a network batch) costs a single update of 
+ * the free list instead of one per chunk: the first `n` nodes of the free list are unlinked in one 
+ * run. If the free list is too short, the rest is taken from the chunks never handed out (lazy mode), 
+ * which are contiguous, cleared with a single `memset` and marked live a word at a time in a tracked 
+ * pool.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool` structure from which to allocate memory.
+ * - **out**: An array of at least `n` pointers, receiving the allocated chunks.
+ * - **n**: The number of chunks requested.
+ * 
+ * ### Return:
+ * - **size_t**: The number of chunks allocated, stored at the start of `out`. Less than `n` when the 
+ *   pool runs out of chunks, which does not trigger an assertion contrary to `allocator_pool_alloc`.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n).
+ */
+size_t allocator_pool_alloc_n(Allocator_Pool* allocator, void** out, size_t n);
+
+/**
+ * @brief Allocates up to `n` chunks from the pool allocator at once, without clearing them.
+ * 
+ * Meant for the layers caching chunks (e.g. the magazines of `Allocator_Pool_Magazine_Cache`), which 
+ * clear each chunk when they hand it out: clearing it when it is cached as well would write it twice.
+ * See `allocator_pool_alloc_n`.
+ */
+size_t allocator_pool_alloc_n_no_zero(Allocator_Pool* allocator, void** out, size_t n);
+
+/**
+ * @brief Frees a previously allocated chunk of memory from the pool allocator.
+ * 
+ * This function takes a pointer to a previously allocated chunk and adds it back to the pool's 
+ * free list, making it available for future allocations. It performs bounds checking to ensure the 
+ * pointer belongs to the allocator's buffer. If the pointer is `NULL`, no action is taken.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool` structure where the chunk should be freed.
+ * - **ptr**: A pointer to the chunk that needs to be freed. The pointer must be within the bounds of 
+ *           the allocator's buffer.
+ * 
+ * ### Behavior:
+ * 1. If the pointer is `NULL`, the function simply returns without doing anything.
+ * 2. The function checks that the pointer lies within the bounds of the allocator's buffer.
+ * 3. If the pointer is valid, the function creates a free node from the given chunk and adds it to the 
+ *    free list (linked list) of free chunks.
+ * 4. The chunk is then available for reallocation.
+ * 
+ * ### Example:
+ * ```c
+ * void* chunk = allocator_pool_alloc(&pool);
+ * allocator_pool_free(&pool, chunk); // Free the chunk once done with it
+ * ```
+ * 
+ * ### Assertions:
+ * - Ensures that the pointer passed to the function is within the bounds of the pool's allocated memory.
+ * - Ensures that the pointer is the start of a chunk.
+ * 
+ * ### Notes:
+ * - The function does not perform any memory deallocation or zeroing of the chunk. It merely adds it 
+ *   back to the free list.
+ * - If the pointer is not valid (i.e., not within the pool's memory range), an assertion is triggered.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1), constant time operation as chunks are simply added to the free list.
+ * - **Space Complexity**: O(1), no additional space is required aside from the pointer manipulation.
+ */
+void allocator_pool_free(Allocator_Pool* allocator, void* ptr);
+
+/**
+ * @brief Frees `n` chunks of the pool allocator at once.
+ * 
+ * The chunks are chained together, then the whole chain is spliced in front of the free list with 
+ * a single update of its head. The chunks are reallocated in the order of `ptrs`.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool` structure where the chunks should be freed.
+ * - **ptrs**: The chunks to free. `NULL` entries are skipped.
+ * - **n**: The number of entries of `ptrs`.
+ * 
+ * ### Assertions:
+ * - Ensures that every pointer is within the bounds of the pool's allocated memory.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n).
+ */
+void allocator_pool_free_n(Allocator_Pool* allocator, void** ptrs, size_t n);
+
+/**
+ * @brief Frees all chunks in the pool allocator.
+ * 
+ * This function marks all the chunks in the pool as free by adding each chunk to the free list, 
+ * making all chunks available for future allocations. It effectively resets the pool, allowing 
+ * for reuse of the entire buffer. In lazy mode (`allocator_pool_init_lazy`), the free list is 
+ * emptied and the unused watermark moved back to the start of the buffer instead.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool` structure to free all chunks in.
+ * 
+ * ### Behavior:
+ * 1. The function calculates the number of chunks based on the pool's buffer length and chunk size.
+ * 2. It iterates over all chunks in the pool and adds them to the free list, from the last one, so 
+ *    the chunks are then allocated in ascending address order.
+ * 3. After calling this function, all chunks are available for reallocation.
+ * 
+ * ### Example:
+ * ```c
+ * allocator_pool_free_all(&pool); // Free all chunks in the pool
+ * ```
+ * 
+ * ### Notes:
+ * - This function does not deallocate any memory; it only marks all chunks as available.
+ * - The function operates on the entire pool, effectively resetting its state.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n), where `n` is the number of chunks in the pool. The function iterates over 
+ *   all chunks to add them to the free list. O(1) in lazy mode.
+ * - **Space Complexity**: O(1), no additional space is used, aside from iterating over the chunks.
+ */
+void allocator_pool_free_all(Allocator_Pool* allocator);
+
+/**
+ * @brief Returns the index of the first live chunk at or after `index`, or `buf_len / chunk_size` if there is none.
+ * 
+ * Only available on pools initialized with `allocator_pool_init_tracked`. The chunk of index `i` is 
+ * at `&pool.buf[i * pool.chunk_size]`, the chunks are visited in address order.
+ * 
+ * ### Example:
+ * ```c
+ * size_t chunk_count = pool.buf_len / pool.chunk_size;
+ * for (size_t i = allocator_pool_next_live(&pool, 0); i < chunk_count; i = allocator_pool_next_live(&pool, i + 1)) {
+ *     Entity* entity = (Entity*) &pool.buf[i * pool.chunk_size];
+ *     entity_update(entity);
+ * }
+ * ```
+ * 
+ * ### Assertions:
+ * - Ensures the pool tracks its live chunks.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1) amortized per visited chunk, when the pool is not mostly free.
+ */
+size_t allocator_pool_next_live(const Allocator_Pool* allocator, size_t index);
+
+/**
+ * @brief Sorts the free list of a pool allocator by ascending address.
+ * 
+ * The free list is LIFO: after random frees, consecutive allocations land on scattered addresses, 
+ * which defeats the hardware prefetcher when the objects are later traversed in allocation order 
+ * (e.g. a linked list built node by node). Once sorted, consecutive allocations return consecutive 
+ * free chunks, from the lowest address. Call it at a quiet point, e.g. between two phases of a frame.
+ * 
+ * ### Behavior:
+ * - Pools initialized with `allocator_pool_init_tracked` rebuild the list from their occupancy bitmap.
+ * - Other pools sort the list in place with a bottom-up merge sort, without extra memory.
+ * 
+ * ### Notes:
+ * - `allocator_pool_free_all` already builds an ascending list, and the chunks never handed out 
+ *   (lazy mode) are always allocated in ascending order.
+ * - A pool which must always return its lowest free chunk is better served by `Allocator_Pool_Bitmap`.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n) for tracked pools, O(n log n) over the free chunks otherwise.
+ * - **Space Complexity**: O(1).
+ */
+void allocator_pool_sort_free_list(Allocator_Pool* allocator);
+
+/**
+ * Called by `allocator_pool_compact` for every chunk it moves, after the content of the chunk was 
+ * copied from `old_ptr` to `new_ptr`. It must update every reference to the object (e.g. an entry 
+ * of a handle table, or the pointers stored in other objects).
+ */
+typedef void (*Allocator_Pool_Relocate_Fn)(void* user_data, void* old_ptr, void* new_ptr);
+
+/**
+ * @brief Moves the live chunks of a tracked pool to the front of its buffer.
+ * 
+ * After a load spike, the live chunks of a long-running pool end up scattered across the whole 
+ * buffer. Compaction moves the last live chunk into the first free chunk until the live chunks are 
+ * contiguous, and notifies each move through `relocate`. The pool is then reset to a single free 
+ * region past the live chunks: the free list is emptied, and the unused watermark moved right after 
+ * the last live chunk.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to a pool initialized with `allocator_pool_init_tracked`.
+ * - **relocate**: The callback notified of every move. Must not be `NULL`.
+ * - **user_data**: Passed to `relocate`.
+ * 
+ * ### Return:
+ * - **size_t**: The number of chunks moved.
+ * 
+ * ### Example:
+ * ```c
+ * allocator_pool_compact(&pool, entity_relocate, &world);
+ * allocator_pool_purge_unused(&pool); // Give the pages of the empty tail back to the OS
+ * ```
+ * 
+ * ### Notes:
+ * - Every pointer to a moved chunk which is not updated by `relocate` is left dangling. The pool must 
+ *   not be used from `relocate`.
+ * - The relative order of the live chunks is not preserved.
+ * 
+ * ### Assertions:
+ * - Ensures the pool tracks its live chunks.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n) over the chunks below the watermark, plus the copy of the moved chunks.
+ */
+size_t allocator_pool_compact(Allocator_Pool* allocator, Allocator_Pool_Relocate_Fn relocate, void* user_data);
+
+/**
+ * @brief Gives the pages past the unused watermark of a lazy pool back to the OS (`madvise(MADV_DONTNEED)`).
+ * 
+ * Meant to be called after `allocator_pool_compact`, or after `allocator_pool_free_all`. Only the 
+ * pages which are entirely past the watermark are purged, the range stays usable: purged pages are 
+ * faulted in again when their chunks are allocated, which zeroes them anyway.
+ * 
+ * ### Notes:
+ * - The backing buffer must be made of whole pages mapped by the OS (e.g. `ALLOCATOR_BACKING_MMAP` 
+ *   or `allocator_os_reserve` + `allocator_os_commit`), not part of a `malloc`ed block or of the stack.
+ * - No-op for eager pools, whose free list is stored in all the chunks.
+ */
+void allocator_pool_purge_unused(Allocator_Pool* allocator);
+
+typedef struct Allocator_Pool_Growable Allocator_Pool_Growable;
+
+/**
+ * @struct Allocator_Pool_Slab
+ * Header stored at the start of each slab of an `Allocator_Pool_Growable`.
+ *
+ * A slab is a block of `slab_size` bytes aligned to `slab_size`, so the header of the slab holding 
+ * a chunk is found by rounding the chunk address down (see `allocator_pool_slab_of`).
+ *
+ * @member pool         Lazy pool over the part of the slab following the header.
+ * @member owner        The growable pool the slab belongs to.
+ * @member used_count   Number of chunks of the slab currently allocated.
+ * @member chunk_count  Number of chunks the slab holds.
+ * @member prev         Previous slab in the list (partial or full) the slab is in.
+ * @member next         Next slab in the list (partial or full) the slab is in.
+ */
+typedef struct Allocator_Pool_Slab Allocator_Pool_Slab;
+struct Allocator_Pool_Slab {
+    Allocator_Pool           pool;        // Pool over the chunks of the slab
+    Allocator_Pool_Growable* owner;       // Growable pool the slab belongs to
+    size_t                   used_count;  // Chunks currently allocated
+    size_t                   chunk_count; // Chunks in the slab
+    Allocator_Pool_Slab*     prev;        // Previous slab in the list
+    Allocator_Pool_Slab*     next;        // Next slab in the list
+};
+
+/**
+ * @struct Allocator_Pool_Growable
+ * A pool allocator which adds slabs on demand instead of running out of chunks.
+ *
+ * The chunks live in slabs requested from a backing source. Each slab is an `Allocator_Pool` in lazy 
+ * mode, so a new slab costs nothing to set up. The slabs with free chunks are kept in a "partial" list, 
+ * allocations are served by its first slab; the slabs without free chunk are moved to a "full" list.
+ *
+ * ### Key Features:
+ * - **Constant Time Operations (O(1))**: the slab of a chunk is found by masking its address.
+ * - **Memory Release**: slabs which become empty are given back to the backing source, once more 
+ *   than `retained_empty_slabs` empty slabs are kept around.
+ *
+ * @member partial_slabs         Slabs with at least one free chunk.
+ * @member full_slabs            Slabs without free chunks.
+ * @member backing               Source of the slabs.
+ * @member slab_size             Size (and alignment) of the slabs, in bytes. A power of two.
+ * @member chunk_size            Requested size of each chunk, in bytes.
+ * @member chunk_align           Alignment of each chunk, in bytes.
+ * @member empty_slab_count      Number of slabs without any allocated chunk.
+ * @member retained_empty_slabs  Number of empty slabs kept instead of being released.
+ * @member color_step            Offset between the colors of two slabs, 0 when coloring is disabled.
+ * @member color_next            Offset of the chunks of the next slab, after the header.
+ *
+ * ### Example:
+ * ```c
+ * Allocator_Pool_Growable pool;
+ * allocator_pool_growable_init(&pool, ALLOCATOR_BACKING_MMAP, 64 * 1024, sizeof(Packet), 64, 2);
+ *
+ * Packet* packet = allocator_pool_growable_alloc(&pool);
+ * allocator_pool_growable_free(&pool, packet);
+ *
+ * allocator_pool_growable_destroy(&pool);
+ * ```
+ */
+struct Allocator_Pool_Growable {
+    Allocator_Pool_Slab* partial_slabs;        // Slabs with free chunks
+    Allocator_Pool_Slab* full_slabs;           // Slabs without free chunks
+    Allocator_Backing    backing;              // Source of the slabs
+    size_t               slab_size;            // Size and alignment of the slabs, in bytes
+    size_t               chunk_size;           // Size of the chunks, in bytes
+    size_t               chunk_align;          // Alignment of the chunks, in bytes
+    size_t               empty_slab_count;     // Slabs without any allocated chunk
+    size_t               retained_empty_slabs; // Empty slabs kept instead of being released
+    size_t               color_step;           // Offset between two slab colors, 0 when disabled
+    size_t               color_next;           // Color of the next slab
+};
+
+/**
+ * @brief Returns the header of the slab holding `ptr`, for slabs of `slab_size` bytes aligned to their size.
+ */
+static inline Allocator_Pool_Slab* allocator_pool_slab_of(void* ptr, size_t slab_size) {
+    return (Allocator_Pool_Slab*) ((uintptr_t) ptr & ~((uintptr_t) slab_size - 1));
+}
+
+/**
+ * @brief Initializes a growable pool allocator.
+ * 
+ * No slab is requested at initialization, the first allocation requests one.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool_Growable` structure to initialize.
+ * - **backing**: The source of the slabs. It must honor alignments as large as `slab_size`.
+ * - **slab_size**: The size of each slab in bytes, header included. Must be a power of two.
+ * - **chunk_size**: The size of each chunk in bytes. This is aligned to the specified alignment.
+ * - **chunk_align**: The alignment for each chunk. Must be a power of two.
+ * - **retained_empty_slabs**: How many empty slabs are kept instead of being given back to the backing source.
+ * 
+ * ### Assertions:
+ * - Ensures `slab_size` is a power of two, large enough for the slab header and one chunk.
+ */
+void allocator_pool_growable_init(Allocator_Pool_Growable* allocator, Allocator_Backing backing, size_t slab_size, size_t chunk_size, size_t chunk_align, size_t retained_empty_slabs);
+
+/**
+ * @brief Enables slab coloring: the chunks of each new slab are shifted by a rotating offset.
+ * 
+ * Slabs are aligned to their size, so without coloring the chunk `i` of every slab sits at the same 
+ * offset from a large power of two, and the hot fields of those chunks all map to the same L1/L2 cache 
+ * sets, evicting each other (conflict misses). As in the Solaris slab allocator, the bytes left over 
+ * at the end of a slab (the slab size is rarely a multiple of the chunk size) are spread between the 
+ * header and the first chunk instead: the first slab is shifted by 0, the next by `color_step`, the 
+ * next by `2 * color_step`... wrapping to 0 once the left over bytes are exhausted.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool_Growable` structure.
+ * - **color_step**: The offset between two colors, usually `ALLOCATOR_CACHE_LINE_SIZE`. Must be a power 
+ *   of two and a multiple of the chunk alignment. 0 disables coloring.
+ * 
+ * ### Notes:
+ * - Coloring never reduces the number of chunks of a slab, it only uses the left over bytes. A slab 
+ *   without left over bytes (e.g. 64 chunks of 1 KiB in a 64 KiB slab, with the header) has a single 
+ *   color: pick a slab size leaving room, e.g. 4 KiB chunks in 64 KiB slabs leave almost 4 KiB, which 
+ *   is 63 colors of a cache line.
+ * - Only slabs created after the call are colored.
+ * 
+ * ### Assertions:
+ * - Ensures `color_step` is a power of two and a multiple of the chunk alignment.
+ */
+void allocator_pool_growable_set_coloring(Allocator_Pool_Growable* allocator, size_t color_step);
+
+/**
+ * @brief Allocates a zero-initialized chunk from a growable pool allocator.
+ * 
+ * The chunk is taken from the first slab with free chunks. If every slab is full, a new slab is 
+ * requested from the backing source.
+ * 
+ * ### Return:
+ * - **void***: A pointer to the chunk, or `NULL` if the backing source failed to provide a new slab.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void* allocator_pool_growable_alloc(Allocator_Pool_Growable* allocator);
+
+/**
+ * @brief Frees a chunk of a growable pool allocator.
+ * 
+ * The chunk goes back to the free list of its slab. When the slab becomes empty and more than 
+ * `retained_empty_slabs` slabs are empty, the slab is given back to the backing source.
+ * 
+ * ### Assertions:
+ * - Ensures the chunk belongs to this pool (the slab header found from the pointer must point back to it).
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void allocator_pool_growable_free(Allocator_Pool_Growable* allocator, void* ptr);
+
+/**
+ * @brief Frees all chunks of a growable pool allocator.
+ * 
+ * Up to `retained_empty_slabs` slabs are kept (and reset), the other ones are given back to the backing source.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(s), where `s` is the number of slabs.
+ */
+void allocator_pool_growable_free_all(Allocator_Pool_Growable* allocator);
+
+/**
+ * @brief Gives every slab of a growable pool allocator back to the backing source.
+ * 
+ * All chunks become invalid. The pool can be used again afterward.
+ */
+void allocator_pool_growable_destroy(Allocator_Pool_Growable* allocator);
+
+/**
+ * @brief Checks whether a pointer is inside one of the slabs of a growable pool allocator.
+ * 
+ * ### Notes:
+ * - Safe to call with any pointer: the candidate slab header is only compared against the known 
+ *   slabs, never dereferenced before being found.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(s), where `s` is the number of slabs.
+ */
+bool allocator_pool_growable_owns(Allocator_Pool_Growable* allocator, void* ptr);
+
+/**
+ * @struct Allocator_Pool_Bitmap
+ * A pool allocator tracking its free chunks with bitmaps stored out of band, instead of an intrusive free list.
+ *
+ * Each chunk has a bit in `free_bits` (set when the chunk is free), and each word of `free_bits` 
+ * has a bit in `summary_bits` (set when the word has at least one free chunk). An allocation finds 
+ * the first non-zero summary word, then the lowest free chunk with two `__builtin_ctzll`. Runs of 
+ * full words are skipped 256 bits at a time with AVX2 when the target supports it.
+ *
+ * ### Key Features:
+ * - **Address Ordered**: the free chunk with the lowest address is always allocated first, consecutive 
+ *   allocations land on consecutive addresses, which helps locality and hardware prefetching.
+ * - **Cold Frees**: freeing a chunk only flips a bit, the chunk memory is never written.
+ * - **Live Objects Iteration**: the allocated chunks are known, see `allocator_pool_bitmap_next_live`.
+ * - **Double Free Detection**: freeing a chunk which is already free asserts.
+ *
+ * @member buf            Pointer to the first chunk, aligned to the chunk alignment.
+ * @member chunk_size     Size of each chunk, in bytes.
+ * @member chunk_count    Number of chunks in the pool.
+ * @member free_bits      One bit per chunk, set when the chunk is free.
+ * @member summary_bits   One bit per `free_bits` word, set when the word has a free chunk.
+ * @member word_count     Number of 64 bits words of `free_bits`.
+ * @member summary_count  Number of 64 bits words of `summary_bits`.
+ * @member search_hint    Summary word to start the searches from, every word before it is zero.
+ *
+ * ### Notes:
+ * - Both bitmaps are carved from the start of the backing buffer: 1 bit per chunk plus 1 bit per 
+ *   64 chunks. With 2 levels, a scan visits at most `chunk_count / 4096` summary words.
+ */
+typedef struct Allocator_Pool_Bitmap {
+    uint8_t*  buf;           // First chunk
+    size_t    chunk_size;    // Size of the chunks, in bytes
+    size_t    chunk_count;   // Number of chunks
+    uint64_t* free_bits;     // One bit per chunk, set if free
+    uint64_t* summary_bits;  // One bit per `free_bits` word, set if it has a free chunk
+    size_t    word_count;    // Number of words of `free_bits`
+    size_t    summary_count; // Number of words of `summary_bits`
+    size_t    search_hint;   // Summary word the searches start from
+} Allocator_Pool_Bitmap;
+
+/**
+ * @brief Initializes a bitmap pool allocator with the given backing buffer, chunk size, and alignment.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool_Bitmap` structure to initialize.
+ * - **backing_buf**: A pointer to the memory block holding the bitmaps and the chunks.
+ * - **backing_buf_len**: The total size of the backing buffer in bytes.
+ * - **chunk_size**: The size of each chunk in bytes. This is aligned to the specified alignment.
+ * - **chunk_align**: The alignment for each chunk. Must be a power of two.
+ * 
+ * ### Notes:
+ * - There is no minimum chunk size: nothing is stored inside the chunks.
+ * 
+ * ### Assertions:
+ * - Ensures `chunk_size` is not 0 and `chunk_align` is a power of two.
+ * - Ensures the backing buffer is large enough to hold the bitmaps and at least one aligned chunk.
+ */
+void allocator_pool_bitmap_init(Allocator_Pool_Bitmap* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align);
+
+/**
+ * @brief Allocates the free chunk with the lowest address from a bitmap pool allocator.
+ * 
+ * ### Return:
+ * - **void***: A pointer to the zero-initialized chunk, or `NULL` if no free chunks are available.
+ * 
+ * ### Assertions:
+ * - Ensures that there is at least one free chunk in the pool before allocation.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1) while the pool is not nearly full, O(n / 4096) in the worst case.
+ */
+void* allocator_pool_bitmap_alloc(Allocator_Pool_Bitmap* allocator);
+
+/**
+ * @brief Frees a chunk of a bitmap pool allocator. If the pointer is `NULL`, no action is taken.
+ * 
+ * ### Assertions:
+ * - Ensures the pointer is the start of a chunk of the pool, and that the chunk is not already free.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void allocator_pool_bitmap_free(Allocator_Pool_Bitmap* allocator, void* ptr);
+
+/**
+ * @brief Frees all chunks of a bitmap pool allocator.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n / 64), only the bitmaps are written.
+ */
+void allocator_pool_bitmap_free_all(Allocator_Pool_Bitmap* allocator);
+
+/**
+ * @brief Returns the index of the first allocated chunk at or after `index`, or `chunk_count` if there is none.
+ * 
+ * Visits the live chunks in address order, skipping 64 chunks at a time where they are all free.
+ * 
+ * ### Example:
+ * ```c
+ * for (size_t i = allocator_pool_bitmap_next_live(&pool, 0); i < pool.chunk_count; i = allocator_pool_bitmap_next_live(&pool, i + 1)) {
+ *     Particle* particle = (Particle*) &pool.buf[i * pool.chunk_size];
+ *     // ...
+ * }
+ * ```
+ */
+size_t allocator_pool_bitmap_next_live(const Allocator_Pool_Bitmap* allocator, size_t index);
+
+/**
+ * Size of a cache line, in bytes. Used to keep the fields written by different threads apart.
+ */
+#ifndef ALLOCATOR_CACHE_LINE_SIZE
+#define ALLOCATOR_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @struct Allocator_Pool_Concurrent_Node
+ * A node of the free list of a concurrent pool allocator, stored inside the free chunk.
+ *
+ * @member next  Index + 1 of the next free chunk, `0` for the end of the list.
+ */
+typedef struct Allocator_Pool_Concurrent_Node {
+    _Atomic uint32_t next; // Index + 1 of the next free chunk
+} Allocator_Pool_Concurrent_Node;
+
+/**
+ * @struct Allocator_Pool_Concurrent
+ * A pool allocator which can be shared by several threads without a lock.
+ *
+ * The free list is a lock-free (Treiber) stack: allocations pop its head and frees push on it with 
+ * a compare-and-swap. To defeat the ABA problem without a 128 bits CAS, the head packs a 32 bits 
+ * tag, incremented on every update, with the 32 bits index of the first free chunk.
+ *
+ * Like the lazy mode of `Allocator_Pool`, the free list starts empty: chunks never handed out are 
+ * taken from an unused watermark, so initialization and reset are O(1).
+ *
+ * @member buf           Pointer to the first chunk, aligned to the chunk alignment.
+ * @member chunk_size    Size of each chunk, in bytes.
+ * @member chunk_count   Number of chunks in the pool (at most `UINT32_MAX - 1`).
+ * @member head          Tagged head of the free list.
+ * @member unused_index  Index of the first chunk never handed out since the last reset.
+ *
+ * ### Notes:
+ * - The contended fields are kept on their own cache lines.
+ * - A popping thread may read the `next` field of a chunk another thread just allocated: the read 
+ *   is harmless (the CAS fails) but requires the buffer to stay mapped while the pool is in use.
+ */
+typedef struct Allocator_Pool_Concurrent {
+    uint8_t* buf;         // First chunk
+    size_t   chunk_size;  // Size of the chunks, in bytes
+    size_t   chunk_count; // Number of chunks
+
+    _Alignas(ALLOCATOR_CACHE_LINE_SIZE) _Atomic uint64_t head;         // Tagged head of the free list
+    _Alignas(ALLOCATOR_CACHE_LINE_SIZE) _Atomic size_t   unused_index; // First chunk never handed out
+} Allocator_Pool_Concurrent;
+
+/**
+ * @brief Initializes a concurrent pool allocator with the given backing buffer, chunk size, and alignment.
+ * 
+ * Same parameters and assertions as `allocator_pool_init`. Initialization is not thread-safe, the 
+ * pool must be published to the other threads afterward.
+ */
+void allocator_pool_concurrent_init(Allocator_Pool_Concurrent* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align);
+
+/**
+ * @brief Allocates a zero-initialized chunk from a concurrent pool allocator. Thread-safe and lock-free.
+ * 
+ * ### Return:
+ * - **void***: A pointer to the chunk, or `NULL` if no free chunks are available. Contrary to 
+ *   `allocator_pool_alloc`, running out of chunks does not assert, as it is a normal outcome of contention.
+ */
+void* allocator_pool_concurrent_alloc(Allocator_Pool_Concurrent* allocator);
+
+/**
+ * @brief Frees a chunk of a concurrent pool allocator. Thread-safe and lock-free.
+ * 
+ * ### Assertions:
+ * - Ensures that the pointer passed to the function is within the bounds of the pool's allocated memory.
+ */
+void allocator_pool_concurrent_free(Allocator_Pool_Concurrent* allocator, void* ptr);
+
+/**
+ * @brief Frees all chunks of a concurrent pool allocator in O(1).
+ * 
+ * ### Notes:
+ * - Must not be called while other threads are using the pool.
+ */
+void allocator_pool_concurrent_free_all(Allocator_Pool_Concurrent* allocator);
+
+/**
+ * @struct Allocator_Pool_Magazine
+ * A magazine: a small stack of free chunks ("rounds") cached by a thread, exchanged whole with the depot.
+ *
+ * @member next    Next magazine in the depot list the magazine is in.
+ * @member count   Number of rounds in the magazine.
+ * @member rounds  The cached chunks, `magazine_size` entries.
+ */
+typedef struct Allocator_Pool_Magazine Allocator_Pool_Magazine;
+struct Allocator_Pool_Magazine {
+    Allocator_Pool_Magazine* next;     // Next magazine in the depot list
+    size_t                   count;    // Number of rounds in the magazine
+    void*                    rounds[]; // Cached chunks
+};
+
+/**
+ * @struct Allocator_Pool_Depot
+ * The central layer of a magazine-cached pool: a pool shared by several threads, and the magazines 
+ * the threads exchange with it, all protected by a single lock.
+ *
+ * Threads never allocate chunks from the depot one by one: their `Allocator_Pool_Magazine_Cache` 
+ * trades a whole magazine at once (an empty one for a full one on allocation, the opposite on free), 
+ * so the lock is only taken once every `magazine_size` operations at most. This is the magazine layer 
+ * of Bonwick's slab allocator, also found as the transfer cache of tcmalloc.
+ *
+ * @member lock             Protects every other member, and the pool.
+ * @member pool             The pool the chunks come from.
+ * @member full_magazines   Magazines full of free chunks, ready for allocations.
+ * @member empty_magazines  Empty magazines, ready for frees.
+ * @member backing          Source of the memory of the magazines themselves.
+ * @member magazine_size    Number of rounds of each magazine.
+ *
+ * ### Example:
+ * ```c
+ * Allocator_Pool_Depot depot;                          // Shared
+ * allocator_pool_depot_init(&depot, &pool, ALLOCATOR_BACKING_MALLOC, 64);
+ *
+ * static _Thread_local Allocator_Pool_Magazine_Cache cache;
+ * allocator_pool_magazine_cache_init(&cache, &depot);  // In each thread
+ * void* chunk = allocator_pool_magazine_cache_alloc(&cache);
+ * allocator_pool_magazine_cache_free(&cache, chunk);
+ * allocator_pool_magazine_cache_flush(&cache);         // Before the thread exits
+ * ```
+ */
+typedef struct Allocator_Pool_Depot {
+    pthread_mutex_t          lock;            // Protects the depot and the pool
+    Allocator_Pool*          pool;            // Pool the chunks come from
+    Allocator_Pool_Magazine* full_magazines;  // Magazines full of free chunks
+    Allocator_Pool_Magazine* empty_magazines; // Empty magazines
+    Allocator_Backing        backing;         // Source of the magazines memory
+    size_t                   magazine_size;   // Number of rounds of each magazine
+} Allocator_Pool_Depot;
+
+/**
+ * @struct Allocator_Pool_Magazine_Cache
+ * The per-thread layer of a magazine-cached pool, holding two magazines.
+ *
+ * Allocations pop from the loaded magazine and frees push to it, without any lock nor atomic 
+ * operation. When the loaded magazine is empty (on allocation) or full (on free), it is swapped 
+ * with the previous one if that one can serve the operation, and only then is the depot involved. 
+ * Keeping two magazines prevents thrashing the depot when alternating allocations and frees 
+ * around a magazine boundary.
+ *
+ * @member depot     The depot the magazines are exchanged with.
+ * @member loaded    Magazine the operations are served from.
+ * @member previous  The other magazine, kept full or empty.
+ */
+typedef struct Allocator_Pool_Magazine_Cache {
+    Allocator_Pool_Depot*    depot;    // Depot the magazines are exchanged with
+    Allocator_Pool_Magazine* loaded;   // Magazine serving the operations
+    Allocator_Pool_Magazine* previous; // Spare magazine
+} Allocator_Pool_Magazine_Cache;
+
+/**
+ * @brief Initializes a magazine depot in front of a pool.
+ * 
+ * ### Parameters:
+ * - **depot**: A pointer to the `Allocator_Pool_Depot` to initialize.
+ * - **pool**: The pool the chunks come from. Once given to the depot, it must only be accessed through it.
+ * - **backing**: The source of the memory of the magazines.
+ * - **magazine_size**: The number of chunks per magazine. Larger magazines take the lock less 
+ *   often but keep more chunks idle in each thread.
+ */
+void allocator_pool_depot_init(Allocator_Pool_Depot* depot, Allocator_Pool* pool, Allocator_Backing backing, size_t magazine_size);
+
+/**
+ * @brief Gives the chunks of every magazine of a depot back to its pool, and releases the magazines.
+ * 
+ * ### Notes:
+ * - Every cache using the depot must have been flushed before.
+ */
+void allocator_pool_depot_destroy(Allocator_Pool_Depot* depot);
+
+/**
+ * @brief Initializes the magazine cache of a thread. No magazine is taken until the first operation.
+ */
+void allocator_pool_magazine_cache_init(Allocator_Pool_Magazine_Cache* cache, Allocator_Pool_Depot* depot);
+
+/**
+ * @brief Allocates a zero-initialized chunk through the magazine cache of the calling thread.
+ * 
+ * ### Return:
+ * - **void***: A pointer to the chunk, or `NULL` if neither the depot nor the pool have a free chunk.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1), without lock nor atomic operation while one of the magazines has a chunk.
+ */
+void* allocator_pool_magazine_cache_alloc(Allocator_Pool_Magazine_Cache* cache);
+
+/**
+ * @brief Frees a chunk through the magazine cache of the calling thread.
+ * 
+ * The chunk can come from the cache of any thread using the same depot.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1), without lock nor atomic operation while one of the magazines has room.
+ */
+void allocator_pool_magazine_cache_free(Allocator_Pool_Magazine_Cache* cache, void* ptr);
+
+/**
+ * @brief Gives both magazines of a cache back to the depot, e.g. before the thread exits.
+ * 
+ * Full magazines stay cached in the depot for the other threads, the chunks of partially 
+ * filled magazines are given back to the pool.
+ */
+void allocator_pool_magazine_cache_flush(Allocator_Pool_Magazine_Cache* cache);
+
+/**
+ * @struct Allocator_Pool_Owned
+ * A pool allocator owned by one thread, which any thread can free chunks to.
+ *
+ * Only the owner thread allocates, and its allocations and frees go through a plain (lazy) 
+ * `Allocator_Pool` without any synchronization. A chunk freed by another thread is pushed on a 
+ * lock-free multi-producer single-consumer "remote free" list instead. The owner collects that list 
+ * in bulk, with a single atomic exchange, when its local free list is empty: the remotely freed 
+ * chunks are reused before the chunks never handed out (lazy mode). This is the scheme 
+ * of mimalloc's thread-free lists: objects allocated on one thread and freed on another stay correct 
+ * without a shared lock.
+ *
+ * @member pool              The local pool, only accessed by the owner thread.
+ * @member owner             The thread allowed to allocate, set at initialization.
+ * @member remote_free_head  Chunks freed by other threads, waiting to be collected by the owner.
+ *
+ * ### Notes:
+ * - Pushing on the remote list uses a CAS loop, taking it whole uses an exchange: as the only 
+ *   consumer never pops single nodes, the list is not subject to the ABA problem.
+ */
+typedef struct Allocator_Pool_Owned {
+    Allocator_Pool pool;  // Local pool of the owner thread
+    pthread_t      owner; // Thread allowed to allocate
+
+    _Alignas(ALLOCATOR_CACHE_LINE_SIZE) _Atomic(Allocator_Pool_Free_Node*) remote_free_head; // Chunks freed by other threads
+} Allocator_Pool_Owned;
+
+/**
+ * @brief Initializes a pool owned by the calling thread.
+ * 
+ * Same parameters and assertions as `allocator_pool_init`. The local pool is set up in lazy mode.
+ */
+void allocator_pool_owned_init(Allocator_Pool_Owned* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align);
+
+/**
+ * @brief Allocates a zero-initialized chunk from an owned pool. Owner thread only.
+ * 
+ * When the local free list is empty, the chunks freed by other threads are collected before a chunk 
+ * never handed out is taken, so the memory in use only grows when no freed chunk is left.
+ * 
+ * ### Assertions:
+ * - Ensures the caller is the owner thread.
+ * - Ensures there is a free chunk, locally or remotely freed (see `allocator_pool_alloc`).
+ */
+void* allocator_pool_owned_alloc(Allocator_Pool_Owned* allocator);
+
+/**
+ * @brief Frees a chunk of an owned pool, from any thread.
+ * 
+ * The owner thread frees to its local pool, the other threads push the chunk on the remote free list.
+ * 
+ * ### Assertions:
+ * - Ensures the pointer is the start of a chunk of the pool. The chunks pushed remotely go through 
+ *   `allocator_pool_free` once collected, which applies its remaining checks.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1) for the owner, lock-free for the other threads.
+ */
+void allocator_pool_owned_free(Allocator_Pool_Owned* allocator, void* ptr);
+
+/**
+ * @brief Moves every chunk freed by other threads to the local free list. Owner thread only.
+ * 
+ * Called automatically by `allocator_pool_owned_alloc` when the local free list is empty, it can also 
+ * be called at a convenient time (e.g. between two batches) to keep the remote list short.
+ * 
+ * ### Return:
+ * - **size_t**: The number of chunks collected.
+ */
+size_t allocator_pool_owned_collect(Allocator_Pool_Owned* allocator);
+
+/**
+ * Number of bits of a slot map handle used for the slot index. The remaining bits hold the generation.
+ */
+#ifndef ALLOCATOR_POOL_HANDLE_INDEX_BITS
+#define ALLOCATOR_POOL_HANDLE_INDEX_BITS 20
+#endif
+
+#define ALLOCATOR_POOL_HANDLE_INDEX_MASK ((UINT32_C(1) << ALLOCATOR_POOL_HANDLE_INDEX_BITS) - 1)
+#define ALLOCATOR_POOL_HANDLE_GENERATION_MAX (UINT32_MAX >> ALLOCATOR_POOL_HANDLE_INDEX_BITS)
+
+/**
+ * A 32 bits reference to an object of an `Allocator_Pool_Slot_Map`: the index of its slot in the low 
+ * `ALLOCATOR_POOL_HANDLE_INDEX_BITS` bits, and the generation of the slot in the high bits.
+ * 
+ * The handle `ALLOCATOR_POOL_HANDLE_NULL` (0) never refers to an object, generations start at 1.
+ */
+typedef uint32_t Allocator_Pool_Handle;
+
+#define ALLOCATOR_POOL_HANDLE_NULL ((Allocator_Pool_Handle) 0)
+
+/**
+ * @struct Allocator_Pool_Slot
+ * An entry of the slot map's indirection table.
+ */
+typedef struct Allocator_Pool_Slot {
+    uint32_t index;      // Position of the object in the dense chunks when live, next free slot otherwise
+    uint32_t generation; // Incremented each time the object of the slot is freed, wraps to 1
+} Allocator_Pool_Slot;
+
+/**
+ * @struct Allocator_Pool_Slot_Map
+ * A pool of fixed size chunks referenced through generational 32 bits handles instead of raw pointers.
+ *
+ * A handle goes through a table of slots to find its chunk. Each slot holds a generation, which is 
+ * incremented when its object is freed: a handle whose generation does not match its slot is stale, 
+ * and looking it up returns `NULL` instead of a pointer to a reused chunk.
+ *
+ * The live objects are kept packed at the start of `buf`: freeing an object moves the last one into 
+ * its place, so iterating over them is a linear walk over `count` chunks. Pointers returned by 
+ * `allocator_pool_slot_map_get` are thus only valid until the next free, the handles are the stable 
+ * references.
+ *
+ * ### Notes:
+ * - The chunks are not managed by an `Allocator_Pool`: with the live objects kept packed, the chunks 
+ *   in use are always the first `count` ones, so there are never holes for a free list to track. The 
+ *   storage is the same contiguous array of aligned chunks, allocating appends at `count` and freeing 
+ *   shrinks it, and the pool's intrusive free list would only cost a write in each freed chunk.
+ * - The slot table, the back references from chunks to slots and the chunks all live in the backing 
+ *   buffer, which costs 12 bytes per chunk on top of the chunk itself.
+ * - Every slot is handed out once before any is reused, then the free slots are reused in the order 
+ *   they were freed (FIFO), so the frees are spread over the generations of all the slots.
+ * - The generation of a slot wraps from `ALLOCATOR_POOL_HANDLE_GENERATION_MAX` back to 1. A stale 
+ *   handle matches again (ABA) if its slot is reused exactly a multiple of 
+ *   `ALLOCATOR_POOL_HANDLE_GENERATION_MAX` times while the handle is kept, which takes at least that 
+ *   many times `capacity - count` frees. Handles kept that long must be dropped or revalidated.
+ * - This allocator is not thread safe.
+ */
+typedef struct Allocator_Pool_Slot_Map {
+    uint8_t*             buf;             // Dense chunks, the first `count` ones are live
+    uint32_t*            chunk_slots;     // Slot of each live chunk, used to patch the slot of a moved chunk
+    Allocator_Pool_Slot* slots;           // Indirection table, indexed by the handles
+    size_t               chunk_size;      // Size of the chunks, in bytes
+    uint32_t             capacity;        // Number of chunks and slots
+    uint32_t             count;           // Number of live objects
+    uint32_t             free_slot_head;  // First free slot to reuse, or `capacity` if there is none
+    uint32_t             free_slot_tail;  // Last free slot, where freed slots are queued
+    uint32_t             unused_slot;     // First slot never handed out
+} Allocator_Pool_Slot_Map;
+
+/**
+ * @brief Initializes a slot map with the given backing buffer, chunk size, and alignment.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Pool_Slot_Map` structure to initialize.
+ * - **backing_buf**: A pointer to the memory block holding the slots and the chunks.
+ * - **backing_buf_len**: The total size of the backing buffer in bytes.
+ * - **chunk_size**: The size of each chunk in bytes. This is aligned to the specified alignment.
+ * - **chunk_align**: The alignment for each chunk. Must be a power of two.
+ * 
+ * ### Assertions:
+ * - Ensures the backing buffer is large enough to hold at least one chunk and its slot.
+ * 
+ * ### Notes:
+ * - The capacity is capped to `2^ALLOCATOR_POOL_HANDLE_INDEX_BITS` chunks.
+ */
+void allocator_pool_slot_map_init(Allocator_Pool_Slot_Map* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align);
+
+/**
+ * @brief Allocates a zero-initialized chunk from the slot map and returns its handle.
+ * 
+ * ### Return:
+ * - **Allocator_Pool_Handle**: The handle of the new object, or `ALLOCATOR_POOL_HANDLE_NULL` if the map is full.
+ * 
+ * ### Assertions:
+ * - Ensures that there is at least one free chunk in the map before allocation.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+Allocator_Pool_Handle allocator_pool_slot_map_alloc(Allocator_Pool_Slot_Map* allocator);
+
+/**
+ * @brief Returns the chunk referenced by a handle, or `NULL` if the handle is stale or `ALLOCATOR_POOL_HANDLE_NULL`.
+ * 
+ * ### Notes:
+ * - The pointer is invalidated by the next call to `allocator_pool_slot_map_free`, which may move the chunk.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void* allocator_pool_slot_map_get(const Allocator_Pool_Slot_Map* allocator, Allocator_Pool_Handle handle);
+
+/**
+ * @brief Frees the object referenced by a handle. If the handle is `ALLOCATOR_POOL_HANDLE_NULL`, no action is taken.
+ * 
+ * The last live chunk is moved into the freed one to keep the live objects packed, and the generation 
+ * of the slot is incremented so every copy of the handle becomes stale.
+ * 
+ * ### Assertions:
+ * - Ensures the handle is not stale (e.g. a double free).
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(1), plus the copy of one chunk.
+ */
+void allocator_pool_slot_map_free(Allocator_Pool_Slot_Map* allocator, Allocator_Pool_Handle handle);
+
+/**
+ * @brief Frees all objects of the slot map. Every handle handed out so far becomes stale.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n) over the slots handed out so far.
+ */
+void allocator_pool_slot_map_free_all(Allocator_Pool_Slot_Map* allocator);
+
+/**
+ * @brief Returns the handle of the live object stored at the position `index` of the dense chunks.
+ * 
+ * ### Example:
+ * ```c
+ * for (uint32_t i = 0; i < map.count; i += 1) {
+ *     Particle* particle = (Particle*) &map.buf[i * map.chunk_size];
+ *     if (particle->life <= 0) {
+ *         allocator_pool_slot_map_free(&map, allocator_pool_slot_map_handle_at(&map, i));
+ *         i -= 1; // The last object was moved here
+ *     }
+ * }
+ * ```
+ * 
+ * ### Assertions:
+ * - Ensures `index` is lower than `count`.
+ */
+Allocator_Pool_Handle allocator_pool_slot_map_handle_at(const Allocator_Pool_Slot_Map* allocator, uint32_t index);
+
+/**
+ * Placement policies of `Allocator_Free_List`.
+ *
+ * Values:
+ * - `ALLOCATOR_FREE_LIST_FIRST_FIT`:
+ *   The first free block large enough is used. Fast, but splits the blocks at the head of the list.
+ * - `ALLOCATOR_FREE_LIST_BEST_FIT`:
+ *   The smallest free block large enough is used, which walks the whole list (unless a block of the 
+ *   exact size is found) but keeps the large blocks for large requests.
+ */
+typedef enum Allocator_Free_List_Policy {
+    ALLOCATOR_FREE_LIST_FIRST_FIT, // First free block large enough
+    ALLOCATOR_FREE_LIST_BEST_FIT,  // Smallest free block large enough
+} Allocator_Free_List_Policy;
+
+/**
+ * Header stored in front of every block of an `Allocator_Free_List`, allocated or free.
+ *
+ * Members:
+ * - `size_t prev_size`:
+ *   Size of the previous block, only valid when the previous block is free. This is the boundary 
+ *   tag ("footer") of the previous block, stored in this header rather than at its end.
+ * - `size_t size`:
+ *   Size of the block, header included. The two low bits hold flags: whether the block is used, 
+ *   and whether the previous block is used.
+ */
+typedef struct Allocator_Free_List_Header {
+    size_t prev_size; // Size of the previous block, when it is free
+    size_t size;      // Size of the block, header included, and flags in the low bits
+} Allocator_Free_List_Header;
+
+/**
+ * Links of a free block, stored right after its header.
+ */
+typedef struct Allocator_Free_List_Node Allocator_Free_List_Node;
+struct Allocator_Free_List_Node {
+    Allocator_Free_List_Node* next; // Next free block
+    Allocator_Free_List_Node* prev; // Previous free block
+};
+
+/**
+ * A general purpose allocator for allocations of any size and lifetime, over a single backing buffer.
+ *
+ * The buffer is split into blocks, each starting with a `Allocator_Free_List_Header`. Free blocks 
+ * are kept in a doubly linked list, an allocation takes a free block according to the placement 
+ * policy and splits off what it does not need. Each block knows the size of its free neighbors 
+ * (boundary tags), so freeing a block merges it with its free neighbors in O(1), without walking 
+ * the list: two free blocks are never adjacent.
+ *
+ * Members:
+ * - `uint8_t* buf`:
+ *   Pointer to the first block, the aligned start of the backing buffer.
+ * - `size_t buf_len`:
+ *   Length of the blocks area, in bytes, ending with an empty "used" block stopping the merges.
+ * - `Allocator_Free_List_Node* head`:
+ *   First free block.
+ * - `Allocator_Free_List_Policy policy`:
+ *   How a free block is chosen, see `Allocator_Free_List_Policy`.
+ *
+ * ### Key Characteristics:
+ * - Allocations and frees in any order, as with `malloc`, in a buffer the user controls.
+ * - `2 * sizeof(size_t)` bytes of header per allocation, and allocations are rounded up to 
+ *   `DEFAULT_ALIGNEMENT`, with a minimum of `4 * sizeof(void*)` bytes per block.
+ * - A resize grows in place when the following block is free, and shrinks in place.
+ *
+ * ### Notes:
+ * - Allocations are zero-initialized.
+ * - This allocator is not thread safe.
+ */
+typedef struct Allocator_Free_List {
+    uint8_t* buf;     // First block
+    size_t   buf_len; // Length of the blocks, in bytes
+
+    Allocator_Free_List_Node*  head;   // First free block
+    Allocator_Free_List_Policy policy; // How a free block is chosen
+} Allocator_Free_List;
+
+/**
+ * Initializes a free list allocator with a specified backing buffer.
+ *
+ * The whole buffer starts as a single free block.
+ *
+ * @param allocator       Pointer to the `Allocator_Free_List` structure to initialize.
+ * @param backing_buf     Pointer to the memory buffer that the allocator will manage.
+ * @param backing_buf_len Size of the backing buffer, in bytes.
+ *
+ * ### Notes:
+ * - The backing buffer must remain valid for the duration of the allocator's use.
+ * - The placement policy is `ALLOCATOR_FREE_LIST_FIRST_FIT`, see `allocator_free_list_set_policy`.
+ *
+ * ### Assertions:
+ * - Ensures the backing buffer can hold at least one block.
+ */
+void allocator_free_list_init(Allocator_Free_List* allocator, void* backing_buf, size_t backing_buf_len);
+
+/**
+ * Sets how a free list allocator chooses the free block of an allocation.
+ *
+ * @param allocator  Pointer to the `Allocator_Free_List`.
+ * @param policy     The new placement policy, see `Allocator_Free_List_Policy`.
+ */
+void allocator_free_list_set_policy(Allocator_Free_List* allocator, Allocator_Free_List_Policy policy);
+
+/**
+ * Allocates zero-initialized memory from a free list allocator with the specified alignment.
+ *
+ * @param allocator   Pointer to the `Allocator_Free_List`.
+ * @param data_size   Size of the data to allocate, in bytes.
+ * @param data_align  Alignment requirement, in bytes. Must be a power of two.
+ *
+ * @return A pointer to the allocated memory, or NULL if no free block is large enough.
+ *
+ * ### Notes:
+ * - An alignment larger than `DEFAULT_ALIGNEMENT` may leave a gap in front of the allocation, 
+ *   which stays a free block when it is large enough to be one.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(n) over the free blocks in the worst case, O(1) when the first free 
+ *   block fits with the first fit policy.
+ */
+void* allocator_free_list_alloc_align(Allocator_Free_List* allocator, size_t data_size, size_t data_align);
+
+/**
+ * Allocates zero-initialized memory from a free list allocator with the default alignment.
+ * See `allocator_free_list_alloc_align`.
+ */
+void* allocator_free_list_alloc(Allocator_Free_List* allocator, size_t data_size);
+
+/**
+ * Frees memory allocated by a free list allocator. If the pointer is `NULL`, no action is taken.
+ *
+ * The block is merged with the previous and the following blocks when they are free.
+ *
+ * ### Assertions:
+ * - Ensures the pointer is within the bounds of the allocator's buffer, and not already free.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void allocator_free_list_free(Allocator_Free_List* allocator, void* ptr);
+
+/**
+ * Frees every allocation of a free list allocator at once, the buffer becomes a single free block again.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void allocator_free_list_free_all(Allocator_Free_List* allocator);
+
+/**
+ * Resizes memory allocated by a free list allocator, with the specified alignment.
+ *
+ * @param allocator   Pointer to the `Allocator_Free_List`.
+ * @param old_memory  Pointer to the memory to resize. Can be `NULL` to allocate new memory.
+ * @param old_size    The size of the original allocation, in bytes.
+ * @param new_size    The desired new size, in bytes. 0 frees the memory and returns NULL.
+ * @param align       Alignment requirement for the memory. Must be a power of two.
+ *
+ * @return A pointer to the resized memory, or NULL if allocation fails (`old_memory` is then left 
+ *         untouched).
+ *
+ * ### Behavior:
+ * - **Shrinking**: done in place, the end of the block is given back as a free block when it is 
+ *   large enough to be one.
+ * - **Growing in place**: when the block following the allocation is free and large enough, it is 
+ *   merged into the allocation, no copy is made.
+ * - **Relocation**: otherwise, a new block is allocated, the data copied and the old block freed.
+ * - The bytes added by the resize are zeroed.
+ *
+ * ### Assertions:
+ * - Ensures `old_memory` is within the bounds of the allocator's buffer.
+ */
+void* allocator_free_list_resize_align(Allocator_Free_List* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align);
+
+/**
+ * Resizes memory allocated by a free list allocator, with the default alignment.
+ * See `allocator_free_list_resize_align`.
+ */
+void* allocator_free_list_resize(Allocator_Free_List* allocator, void* old_memory, size_t old_size, size_t new_size);
+
+/**
+ * Node of the red-black tree of an `Allocator_Free_Tree`, stored right after the header of a free block.
+ */
+typedef struct Allocator_Free_Tree_Node Allocator_Free_Tree_Node;
+struct Allocator_Free_Tree_Node {
+    Allocator_Free_Tree_Node* left;         // Smaller free blocks
+    Allocator_Free_Tree_Node* right;        // Larger free blocks
+    uintptr_t                 parent_color; // Parent node, with the color (red when set) in the low bit
+};
+
+/**
+ * A general purpose allocator whose free blocks are indexed by a red-black tree, for a best fit in O(log n).
+ *
+ * Same blocks as `Allocator_Free_List` (headers, boundary tags, O(1) merges of free neighbors), but 
+ * the free blocks are kept in a balanced tree ordered by size, then by address, instead of a list. 
+ * An allocation takes the smallest free block large enough, the lowest one among blocks of the same 
+ * size, without walking all the free blocks: the latency of an allocation stays predictable when 
+ * tens of thousands of free blocks are scattered in the buffer of a long-running process.
+ *
+ * Members:
+ * - `uint8_t* buf`:
+ *   Pointer to the first block, the aligned start of the backing buffer.
+ * - `size_t buf_len`:
+ *   Length of the blocks area, in bytes, ending with an empty "used" block stopping the merges.
+ * - `Allocator_Free_Tree_Node* root`:
+ *   Root of the tree of free blocks.
+ *
+ * ### Notes:
+ * - Blocks are at least `2 * sizeof(size_t) + 3 * sizeof(void*)` bytes, rounded up to `DEFAULT_ALIGNEMENT`.
+ * - An allocation aligned to more than `DEFAULT_ALIGNEMENT` searches for a block which fits the 
+ *   worst case gap in front of the allocation. The unused part of the gap goes back to the tree.
+ * - Allocations are zero-initialized.
+ * - This allocator is not thread safe.
+ */
+typedef struct Allocator_Free_Tree {
+    uint8_t* buf;     // First block
+    size_t   buf_len; // Length of the blocks, in bytes
+
+    Allocator_Free_Tree_Node* root; // Tree of the free blocks
+} Allocator_Free_Tree;
+
+/**
+ * Initializes a free tree allocator with a specified backing buffer.
+ *
+ * The whole buffer starts as a single free block.
+ *
+ * @param allocator       Pointer to the `Allocator_Free_Tree` structure to initialize.
+ * @param backing_buf     Pointer to the memory buffer that the allocator will manage.
+ * @param backing_buf_len Size of the backing buffer, in bytes.
+ *
+ * ### Assertions:
+ * - Ensures the backing buffer can hold at least one block.
+ */
+void allocator_free_tree_init(Allocator_Free_Tree* allocator, void* backing_buf, size_t backing_buf_len);
+
+/**
+ * Allocates zero-initialized memory from a free tree allocator with the specified alignment.
+ *
+ * @param allocator   Pointer to the `Allocator_Free_Tree`.
+ * @param data_size   Size of the data to allocate, in bytes.
+ * @param data_align  Alignment requirement, in bytes. Must be a power of two.
+ *
+ * @return A pointer to the allocated memory, or NULL if no free block is large enough.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(log n) over the free blocks.
+ */
+void* allocator_free_tree_alloc_align(Allocator_Free_Tree* allocator, size_t data_size, size_t data_align);
+
+/**
+ * Allocates zero-initialized memory from a free tree allocator with the default alignment.
+ * See `allocator_free_tree_alloc_align`.
+ */
+void* allocator_free_tree_alloc(Allocator_Free_Tree* allocator, size_t data_size);
+
+/**
+ * Frees memory allocated by a free tree allocator. If the pointer is `NULL`, no action is taken.
+ *
+ * The block is merged with the previous and the following blocks when they are free.
+ *
+ * ### Assertions:
+ * - Ensures the pointer is within the bounds of the allocator's buffer, and not already free.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(log n) over the free blocks.
+ */
+void allocator_free_tree_free(Allocator_Free_Tree* allocator, void* ptr);
+
+/**
+ * Frees every allocation of a free tree allocator at once, the buffer becomes a single free block again.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void allocator_free_tree_free_all(Allocator_Free_Tree* allocator);
+
+/**
+ * Resizes memory allocated by a free tree allocator, with the specified alignment.
+ *
+ * Same behavior as `allocator_free_list_resize_align`: shrinks in place, grows in place when the 
+ * following block is free and large enough, relocates otherwise. The bytes added are zeroed.
+ *
+ * @return A pointer to the resized memory, or NULL if allocation fails (`old_memory` is then left 
+ *         untouched) or `new_size` is 0 (`old_memory` is then freed).
+ *
+ * ### Assertions:
+ * - Ensures `old_memory` is within the bounds of the allocator's buffer.
+ */
+void* allocator_free_tree_resize_align(Allocator_Free_Tree* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align);
+
+/**
+ * Resizes memory allocated by a free tree allocator, with the default alignment.
+ * See `allocator_free_tree_resize_align`.
+ */
+void* allocator_free_tree_resize(Allocator_Free_Tree* allocator, void* old_memory, size_t old_size, size_t new_size);
+
+/**
+ * Maximum number of block orders (sizes) of an `Allocator_Buddy`: blocks range from the minimum 
+ * block size to `min_block_size << (ALLOCATOR_BUDDY_MAX_ORDERS - 1)`.
+ */
+#ifndef ALLOCATOR_BUDDY_MAX_ORDERS
+#define ALLOCATOR_BUDDY_MAX_ORDERS 48
+#endif
+
+/**
+ * Links of a free block of an `Allocator_Buddy`, stored at the start of the block.
+ */
+typedef struct Allocator_Buddy_Node Allocator_Buddy_Node;
+struct Allocator_Buddy_Node {
+    Allocator_Buddy_Node* next; // Next free block of the same order
+    Allocator_Buddy_Node* prev; // Previous free block of the same order
+};
+
+/**
+ * A buddy allocator, handing out blocks whose size is a power of two multiple of a minimum block size.
+ *
+ * A block of order `k` is `min_block_size << k` bytes. To allocate, the smallest free block large 
+ * enough is halved until it has the requested order, the unused halves go to the free list of their 
+ * order. To free, a block is merged with its "buddy" (the other half of the block it was split from, 
+ * found by flipping one bit of its offset) as long as the buddy is free, which rebuilds larger blocks.
+ *
+ * Members:
+ * - `uint8_t* buf`:
+ *   Pointer to the first block, aligned to `min_block_size`.
+ * - `size_t buf_len`:
+ *   Length of the blocks area, a multiple of `min_block_size`.
+ * - `size_t min_block_size`, `size_t min_block_shift`:
+ *   Size of the blocks of order 0, a power of two, and its logarithm.
+ * - `size_t order_count`:
+ *   Number of orders, the largest blocks are of order `order_count - 1`.
+ * - `Allocator_Buddy_Node* free_lists[]`:
+ *   Free blocks of each order, in doubly linked lists so a buddy is unlinked in O(1).
+ * - `uint64_t* free_bits[]`:
+ *   One bit per block of each order, set when the block is in its free list (the buddy check of a merge).
+ * - `uint64_t* split_bits[]`:
+ *   One bit per block of each order, set when the block is split into two halves. This gives the order 
+ *   of a block on free, which does not need its size.
+ * - `size_t bits_len`:
+ *   Size of all the bitmaps, in bytes.
+ *
+ * ### Key Characteristics:
+ * - O(log n) allocation, free and resize, over the number of orders.
+ * - No header in the blocks: a block of order `k` is aligned to `min_block_size << k` relative to 
+ *   `buf`, so with a page-sized minimum block every allocation is page aligned.
+ * - Internal fragmentation: requests are rounded up to a power of two multiple of `min_block_size`.
+ *
+ * ### Notes:
+ * - The bitmaps take about `4 / min_block_size` bit per byte of the buffer, at its start.
+ * - A buffer whose length is not a power of two multiple of `min_block_size` is covered by several 
+ *   top level blocks of decreasing size, the last ones have no buddy.
+ * - Allocations are zero-initialized.
+ * - This allocator is not thread safe.
+ */
+typedef struct Allocator_Buddy {
+    uint8_t* buf;             // First block
+    size_t   buf_len;         // Length of the blocks, in bytes
+    size_t   min_block_size;  // Size of the blocks of order 0
+    size_t   min_block_shift; // log2(min_block_size)
+    size_t   order_count;     // Number of orders
+
+    Allocator_Buddy_Node* free_lists[ALLOCATOR_BUDDY_MAX_ORDERS]; // Free blocks of each order
+    uint64_t*             free_bits[ALLOCATOR_BUDDY_MAX_ORDERS];  // Blocks of each order which are free
+    uint64_t*             split_bits[ALLOCATOR_BUDDY_MAX_ORDERS]; // Blocks of each order which are split
+    size_t                bits_len;                               // Size of the bitmaps, in bytes
+} Allocator_Buddy;
+
+/**
+ * @brief Initializes a buddy allocator with the given backing buffer and minimum block size.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Buddy` structure to initialize.
+ * - **backing_buf**: A pointer to the memory block holding the bitmaps and the blocks.
+ * - **backing_buf_len**: The total size of the backing buffer in bytes.
+ * - **min_block_size**: The size of the smallest blocks, e.g. 4096 for a page-granular cache. Must be 
+ *   a power of two, at least `sizeof(Allocator_Buddy_Node)`.
+ * 
+ * ### Assertions:
+ * - Ensures `min_block_size` is valid, and the backing buffer is large enough for the bitmaps and one block.
+ */
+void allocator_buddy_init(Allocator_Buddy* allocator, void* backing_buf, size_t backing_buf_len, size_t min_block_size);
+
+/**
+ * @brief Allocates a zero-initialized block of at least `size` bytes from a buddy allocator.
+ * 
+ * ### Return:
+ * - **void***: A pointer to the block, aligned to its size (relative to `buf`), or `NULL` if no 
+ *   free block is large enough.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(log n), over the number of orders.
+ */
+void* allocator_buddy_alloc(Allocator_Buddy* allocator, size_t size);
+
+/**
+ * @brief Frees a block of a buddy allocator, merging it with its buddy while the buddy is free. 
+ * If the pointer is `NULL`, no action is taken.
+ * 
+ * ### Assertions:
+ * - Ensures the pointer is the start of a block of the allocator, and the block is not already free.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(log n), over the number of orders.
+ */
+void allocator_buddy_free(Allocator_Buddy* allocator, void* ptr);
+
+/**
+ * @brief Frees all blocks of a buddy allocator.
+ * 
+ * ### Complexity:
+ * - **Time Complexity**: O(n / 64) to clear the bitmaps, plus the number of top level blocks.
+ */
+void allocator_buddy_free_all(Allocator_Buddy* allocator);
+
+/**
+ * @brief Resizes a block of a buddy allocator.
+ * 
+ * ### Parameters:
+ * - **allocator**: A pointer to the `Allocator_Buddy`.
+ * - **old_memory**: The block to resize. Can be `NULL` to allocate a new block.
+ * - **old_size**: The size of the original allocation, in bytes.
+ * - **new_size**: The desired new size, in bytes. 0 frees the block and returns NULL.
+ * 
+ * ### Behavior:
+ * - **Shrinking**: done in place, the upper halves of the block are given back to the free lists.
+ * - **Growing in place**: when the block is the lower half of its parent at each order up to the 
+ *   new one, and each upper half (its buddy) is free, the buddies are merged into the block without 
+ *   any copy.
+ * - **Relocation**: otherwise, a new block is allocated, the data copied and the old block freed.
+ * - The bytes added by the resize are zeroed.
+ * 
+ * ### Return:
+ * - **void***: A pointer to the resized block, or `NULL` if allocation fails (`old_memory` is then left untouched).
+ * 
+ * ### Assertions:
+ * - Ensures `old_memory` is within the bounds of the allocator's buffer.
+ */
+void* allocator_buddy_resize(Allocator_Buddy* allocator, void* old_memory, size_t old_size, size_t new_size);
+
+/**
+ * Log2 of the number of second level lists of an `Allocator_Tlsf`, per power of two of block sizes. 
+ * With 5, the blocks of a list differ in size by at most 1/32 (3%).
+ */
+#ifndef ALLOCATOR_TLSF_SL_LOG2
+#define ALLOCATOR_TLSF_SL_LOG2 5
+#endif
+
+#define ALLOCATOR_TLSF_SL_COUNT (1 << ALLOCATOR_TLSF_SL_LOG2)
+
+/**
+ * Number of first level classes of an `Allocator_Tlsf`. The largest free block indexed is 
+ * `ALLOCATOR_TLSF_SL_COUNT * DEFAULT_ALIGNEMENT << (ALLOCATOR_TLSF_FL_COUNT - 1)` bytes (1 TiB on 64 bits 
+ * targets), a larger buffer is only used up to that size.
+ */
+#ifndef ALLOCATOR_TLSF_FL_COUNT
+#if SIZE_MAX > 0xFFFFFFFFu
+#define ALLOCATOR_TLSF_FL_COUNT 32
+#else
+#define ALLOCATOR_TLSF_FL_COUNT 24
+#endif
+#endif
+
+/**
+ * A two-level segregated fit (TLSF) allocator: general purpose allocations with a bounded, O(1) worst case.
+ *
+ * Same blocks as `Allocator_Free_List` (headers, boundary tags, O(1) merges of free neighbors), but 
+ * the free blocks are spread in `ALLOCATOR_TLSF_FL_COUNT * ALLOCATOR_TLSF_SL_COUNT` lists by size 
+ * class: the first level is the power of two of the size, the second level splits each power of two 
+ * linearly. Two bitmaps record which lists are non-empty. An allocation rounds its size up to the next 
+ * class, so any block of that class fits, and finds the first non-empty class at or above it with two 
+ * bit scans (`__builtin_ctz`), without any search loop. The sizes below 
+ * `ALLOCATOR_TLSF_SL_COUNT * DEFAULT_ALIGNEMENT` all fall in the first level, one list per size.
+ *
+ * Members:
+ * - `uint8_t* buf`:
+ *   Pointer to the first block, the aligned start of the backing buffer.
+ * - `size_t buf_len`:
+ *   Length of the blocks area, in bytes, ending with an empty "used" block stopping the merges.
+ * - `uint32_t fl_bitmap`:
+ *   Bit `i` is set when one of the lists of the first level class `i` is non-empty.
+ * - `uint32_t sl_bitmap[]`:
+ *   Bit `j` of `sl_bitmap[i]` is set when the list `free_lists[i][j]` is non-empty.
+ * - `Allocator_Free_List_Node* free_lists[][]`:
+ *   Free blocks of each class, in doubly linked lists.
+ *
+ * ### Key Characteristics:
+ * - O(1) allocation, free and resize (apart from the copy of a relocation), whatever the number and 
+ *   the sizes of the free blocks: suited to real-time and latency-sensitive paths.
+ * - Good fit: the block used is at most one class larger than the request, and its end is split off.
+ *
+ * ### Notes:
+ * - The structure holds all the list heads, about 8 KiB on 64 bits targets.
+ * - An allocation aligned to more than `DEFAULT_ALIGNEMENT` searches for a block which fits the 
+ *   worst case gap in front of the allocation. The unused part of the gap goes back to the lists.
+ * - Allocations are zero-initialized.
+ * - This allocator is not thread safe.
+ */
+typedef struct Allocator_Tlsf {
+    uint8_t* buf;     // First block
+    size_t   buf_len; // Length of the blocks, in bytes
+
+    uint32_t                  fl_bitmap;                                                   // Non-empty first level classes
+    uint32_t                  sl_bitmap[ALLOCATOR_TLSF_FL_COUNT];                          // Non-empty lists of each first level class
+    Allocator_Free_List_Node* free_lists[ALLOCATOR_TLSF_FL_COUNT][ALLOCATOR_TLSF_SL_COUNT]; // Free blocks of each class
+} Allocator_Tlsf;
+
+/**
+ * Initializes a TLSF allocator with a specified backing buffer.
  *
- * ### Limitations:
- * - Resizing non-recent allocations requires a full copy of the data, which may be inefficient for 
- *   large allocations.
- * - Does not allow control over alignment. For custom alignment, use `allocator_stack_resize_align`.
+ * The whole buffer starts as a single free block.
+ *
+ * @param allocator       Pointer to the `Allocator_Tlsf` structure to initialize.
+ * @param backing_buf     Pointer to the memory buffer that the allocator will manage.
+ * @param backing_buf_len Size of the backing buffer, in bytes.
+ *
+ * ### Assertions:
+ * - Ensures the backing buffer can hold at least one block.
  */
-void* allocator_stack_resize(Allocator_Stack* allocator, void* ptr, size_t old_data_size, size_t new_data_size);
+void allocator_tlsf_init(Allocator_Tlsf* allocator, void* backing_buf, size_t backing_buf_len);
 
 /**
- * @struct Allocator_Pool_Free_Node
- * Represents a node in the free list of a pool allocator.
- * 
- * Each node corresponds to a free chunk of memory in the pool allocator.
- * These nodes form a linked list, where each node points to the next free chunk.
+ * Allocates zero-initialized memory from a TLSF allocator with the specified alignment.
  *
- * @member next Pointer to the next free chunk in the pool.
+ * @param allocator   Pointer to the `Allocator_Tlsf`.
+ * @param data_size   Size of the data to allocate, in bytes.
+ * @param data_align  Alignment requirement, in bytes. Must be a power of two.
+ *
+ * @return A pointer to the allocated memory, or NULL if no free block of a large enough class exists.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
  */
-typedef struct Allocator_Pool_Free_Node Allocator_Pool_Free_Node;
-struct Allocator_Pool_Free_Node {
-    Allocator_Pool_Free_Node *next; // Pointer to the next free chuck in the allocator.
-};
+void* allocator_tlsf_alloc_align(Allocator_Tlsf* allocator, size_t data_size, size_t data_align);
 
 /**
- * @struct Allocator_Pool
- * A pool-based memory allocator (sometimes called block allocator) that manages fixed-size chunks of memory.
+ * Allocates zero-initialized memory from a TLSF allocator with the default alignment.
+ * See `allocator_tlsf_alloc_align`.
+ */
+void* allocator_tlsf_alloc(Allocator_Tlsf* allocator, size_t data_size);
+
+/**
+ * Frees memory allocated by a TLSF allocator. If the pointer is `NULL`, no action is taken.
  *
- * The pool allocator divides a supplied backing buffer into equal-sized chunks
- * and maintains a free list to keep track of available chunks. Allocations are
- * performed by removing a chunk from the free list, and deallocations are
- * performed by adding a chunk back to the free list.
+ * The block is merged with the previous and the following blocks when they are free.
  *
- * ### Key Features:
- * - **Constant Time Operations (O(1))**:
- *   Allocations and deallocations are highly efficient, as they simply
- *   involve updating pointers in the free list.
- * - **Minimized Fragmentation**:
- *   Since all chunks are of equal size, there is no internal fragmentation.
- * - **Batch Allocation**:
- *   Useful for allocating and deallocating groups of objects that share
- *   the same size and often the same lifetime.
+ * ### Assertions:
+ * - Ensures the pointer is within the bounds of the allocator's buffer, and not already free.
  *
- * ### Use Cases:
- * - Managing dynamic objects of uniform size, such as game entities or network packets.
- * - Scenarios where high allocation and deallocation performance is critical.
- * 
- * @member buf             Pointer to the backing buffer used for the pool.
- * @member buf_len         Total size of the backing buffer, in bytes.
- * @member chunk_size      Size of each chunk in the pool, in bytes.
- * @member free_list_head  Pointer to the head of the free list, which tracks
- *                         available chunks in the pool.
+ * ### Complexity:
+ * - **Time Complexity**: O(1).
+ */
+void allocator_tlsf_free(Allocator_Tlsf* allocator, void* ptr);
+
+/**
+ * Frees every allocation of a TLSF allocator at once, the buffer becomes a single free block again.
  *
- * ### Example:
- * ```c
- * uint8_t buffer[1024];
- * Allocator_Pool pool;
- * allocator_pool_init(&pool, buffer, sizeof(buffer), 64);
+ * ### Complexity:
+ * - **Time Complexity**: O(1), the list heads are cleared.
+ */
+void allocator_tlsf_free_all(Allocator_Tlsf* allocator);
+
+/**
+ * Resizes memory allocated by a TLSF allocator, with the specified alignment.
  *
- * void* chunk1 = allocator_pool_alloc(&pool);
- * void* chunk2 = allocator_pool_alloc(&pool);
+ * Same behavior as `allocator_free_list_resize_align`: shrinks in place, grows in place when the 
+ * following block is free and large enough, relocates otherwise. The bytes added are zeroed.
  *
- * allocator_pool_free(&pool, chunk1);
- * allocator_pool_free(&pool, chunk2);
- * ```
+ * @return A pointer to the resized memory, or NULL if allocation fails (`old_memory` is then left 
+ *         untouched) or `new_size` is 0 (`old_memory` is then freed).
  *
- * ### Notes:
- * - The chunk size must be greater than or equal to the size of `Allocator_Pool_Free_Node`.
- * - The pool allocator is ideal for fixed-size allocations but is not suitable for variable-sized allocations.
+ * ### Assertions:
+ * - Ensures `old_memory` is within the bounds of the allocator's buffer.
+ *
+ * ### Complexity:
+ * - **Time Complexity**: O(1), plus the copy of a relocation.
  */
-typedef struct Allocator_Pool {
-    uint8_t* buf;
-    size_t   buf_len;
-    size_t   chunk_size;
+void* allocator_tlsf_resize_align(Allocator_Tlsf* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align);
 
-    Allocator_Pool_Free_Node* free_list_head; // the free list, behaves like LinkedList.
-} Allocator_Pool;
+/**
+ * Resizes memory allocated by a TLSF allocator, with the default alignment.
+ * See `allocator_tlsf_resize_align`.
+ */
+void* allocator_tlsf_resize(Allocator_Tlsf* allocator, void* old_memory, size_t old_size, size_t new_size);
+
+#ifndef ALLOCATOR_SLAB_SLAB_SIZE
+#define ALLOCATOR_SLAB_SLAB_SIZE (256 * 1024) // Size and alignment of the slabs of every class
+#endif
+
+#ifndef ALLOCATOR_SLAB_MAX_CLASSES
+#define ALLOCATOR_SLAB_MAX_CLASSES 64
+#endif
+
+#ifndef ALLOCATOR_SLAB_MAX_CLASS_SIZE
+#define ALLOCATOR_SLAB_MAX_CLASS_SIZE (32 * 1024) // Bound of the size classes, sizes the lookup table
+#endif
+
+// Entries of the class lookup table: 8 bytes granules up to 1 KiB, 128 bytes granules past it
+#define ALLOCATOR_SLAB_LOOKUP_COUNT (1024 / 8 + (ALLOCATOR_SLAB_MAX_CLASS_SIZE - 1024) / 128 + 1)
 
 /**
- * @brief Initializes a pool allocator with the given backing buffer, chunk size, and alignment.
- * 
- * The function sets up a pool allocator that divides the backing buffer into fixed-size chunks 
- * aligned to the specified alignment. The allocator maintains a free list to track available 
- * chunks and prepares the pool for allocations.
- * 
- * ### Parameters:
- * - **allocator**: A pointer to the `Allocator_Pool` structure to initialize.
- * - **backing_buf**: A pointer to the memory block to be used as the backing buffer.
- * - **backing_buf_len**: The total size of the backing buffer in bytes.
- * - **chunk_size**: The size of each chunk in bytes. This is aligned to the specified alignment.
- * - **chunk_align**: The alignment for each chunk. Must be a power of two.
+ * @struct Allocator_Slab
+ * A general purpose allocator for small objects, made of one `Allocator_Pool_Growable` per size class.
+ *
+ * A request is rounded up to the smallest class holding it, and served by the pool of that class, 
+ * which makes allocations and frees almost as cheap as with a single `Allocator_Pool` while accepting 
+ * any size. The class is found in O(1) with a lookup table indexed by the size (8 bytes granules up 
+ * to 1 KiB, 128 bytes granules past it), no search through the classes is needed.
  * 
- * ### Behavior:
- * 1. The backing buffer is aligned to the specified chunk alignment, and any excess bytes at the 
- *    start are excluded from use.
- * 2. The chunk size is aligned to the specified alignment to ensure proper spacing and alignment 
- *    of chunks within the buffer.
- * 3. Assertions verify that the chunk size is at least as large as the size of a free list node 
- *    (`Allocator_Pool_Free_Node`) and that the backing buffer is large enough to hold at least 
- *    one chunk.
- * 4. The free list is initialized to include all chunks within the adjusted backing buffer.
+ * Requests larger than the largest class are "large objects": each one gets its own block from the 
+ * backing source, with a header in front of it.
  * 
+ * The slabs of every class, and the large objects, are aligned to `ALLOCATOR_SLAB_SLAB_SIZE`. So any 
+ * pointer is mapped back to the header in front of it by masking its address, and freeing memory does 
+ * not need its size: the header tells which class pool the chunk belongs to, or that it is a large object.
+ *
+ * ### Key Features:
+ * - **Constant Time Operations (O(1))**: class lookup, allocation, and freeing of small objects.
+ * - **Configurable Classes**: the default table goes from 8 bytes to 32 KiB (8, 16, 32, 48, 64, 80... 
+ *   with about 4 classes per power of two past 128 bytes), a table fitting the sizes of a workload 
+ *   may be given instead.
+ * - **Memory Release**: slabs which become empty are given back, as with `Allocator_Pool_Growable`.
+ *
+ * @member classes         Pools of the size classes, with chunks of the size of their class.
+ * @member class_count     Number of size classes.
+ * @member max_class_size  Size of the largest class, larger requests are large objects.
+ * @member lookup          Index of the class for each granule of request sizes.
+ * @member large_objects   List of the large objects, linked through their header.
+ * @member backing         Source of the slabs and of the large objects.
+ * @member slab_size       Size (and alignment) of the slabs, `ALLOCATOR_SLAB_SLAB_SIZE`.
+ *
  * ### Example:
  * ```c
- * uint8_t buffer[1024];
- * Allocator_Pool pool;
- * allocator_pool_init(&pool, buffer, sizeof(buffer), 64, 16);
+ * Allocator_Slab slab;
+ * allocator_slab_init(&slab, ALLOCATOR_BACKING_MMAP, NULL, 0, 1);
  *
- * void* chunk1 = allocator_pool_alloc(&pool);
- * void* chunk2 = allocator_pool_alloc(&pool);
+ * Node*  node  = allocator_slab_alloc(&slab, sizeof(Node));
+ * char*  name  = allocator_slab_alloc(&slab, name_len + 1);
+ * allocator_slab_free(&slab, name);
+ * allocator_slab_free(&slab, node);
  *
- * allocator_pool_free(&pool, chunk1);
- * allocator_pool_free(&pool, chunk2);
+ * allocator_slab_destroy(&slab);
  * ```
- * 
- * ### Notes:
- * - The alignment must be a power of two to ensure correct behavior.
- * - The `chunk_size` must be greater than or equal to the size of `Allocator_Pool_Free_Node`, 
- *   as the free list nodes are stored within chunks.
- * - The `allocator_pool_free_all` function is called at the end of initialization to reset 
- *   and populate the free list.
- * 
- * ### Assertions:
- * - Ensures `chunk_size` is large enough to store a free list node.
- * - Ensures the backing buffer is large enough to hold at least one aligned chunk.
  */
-void allocator_pool_init(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t size_chunk_align);
+typedef struct Allocator_Slab {
+    Allocator_Pool_Growable classes[ALLOCATOR_SLAB_MAX_CLASSES];  // Pools of the size classes
+    size_t                  class_count;                          // Number of size classes
+    size_t                  max_class_size;                       // Size of the largest class
+    uint8_t                 lookup[ALLOCATOR_SLAB_LOOKUP_COUNT];  // Class index of each granule of sizes
+    Allocator_Pool_Slab*    large_objects;                        // Large objects, through their header
+    Allocator_Backing       backing;                              // Source of the slabs and large objects
+    size_t                  slab_size;                            // Size and alignment of the slabs
+} Allocator_Slab;
 
 /**
- * @brief Allocates a chunk of memory from the pool allocator.
+ * @brief Initializes a slab allocator.
  * 
- * This function provides memory by returning a pointer to a free chunk in the pool. It removes 
- * the chunk from the free list and returns a zero-initialized pointer to the chunk.
- * If there are no available chunks in the pool, the function triggers an assertion and returns `NULL`.
+ * No slab is requested at initialization, the first allocation of each class requests one.
  * 
  * ### Parameters:
- * - **allocator**: A pointer to the `Allocator_Pool` structure from which to allocate memory.
- * 
- * ### Return:
- * - **void***: A pointer to the allocated chunk of memory, or `NULL` if no free chunks are available.
- * 
- * ### Behavior:
- * 1. The function checks the `free_list_head` to see if there are any free chunks available.
- * 2. If no chunks are available (i.e., the free list is empty), it triggers an assertion to indicate 
- *    that the pool is out of memory.
- * 3. If a free chunk is available, the `free_list_head` is updated to point to the next chunk in the 
- *    free list, and the allocated chunk is zero-initialized using `memset`.
- * 
- * ### Example:
- * ```c
- * Allocator_Pool pool;
- * allocator_pool_init(&pool, buffer, 1024, 64, 16);
- * 
- * void* chunk = allocator_pool_alloc(&pool);
- * if (chunk != NULL) {
- *     // Use the allocated chunk...
- * }
- * ```
+ * - **allocator**: A pointer to the `Allocator_Slab` structure to initialize.
+ * - **backing**: The source of the slabs and of the large objects. It must honor alignments as large 
+ *   as `ALLOCATOR_SLAB_SLAB_SIZE` (e.g. `ALLOCATOR_BACKING_MMAP`).
+ * - **class_sizes**: The sizes of the classes in bytes, in increasing order. `NULL` uses the default 
+ *   table, from 8 bytes to 32 KiB.
+ * - **class_count**: The number of entries of `class_sizes`, ignored when it is `NULL`.
+ * - **retained_empty_slabs**: How many empty slabs each class keeps instead of giving them back.
  * 
  * ### Notes:
- * - The function assumes that the pool has been properly initialized using `allocator_pool_init`.
- * - The chunk returned is zero-initialized, ensuring that all allocated memory starts with a clean state.
- * - If the pool runs out of free chunks, the function will assert with an error message.
+ * - The chunks of a class are aligned to the largest power of two dividing its size, up to 
+ *   `DEFAULT_ALIGNEMENT`: a 48 bytes class is 16 bytes aligned, an 8 bytes class only 8 bytes aligned.
  * 
  * ### Assertions:
- * - Ensures that there is at least one free chunk in the pool before allocation.
- * 
- * ### Complexity:
- * - **Time Complexity**: O(1), constant time allocation, as chunks are allocated from the free list.
- * - **Space Complexity**: O(1), no additional space is used for allocation other than the chunk.
+ * - Ensures there are between 1 and `ALLOCATOR_SLAB_MAX_CLASSES` classes, no larger than 
+ *   `ALLOCATOR_SLAB_MAX_CLASS_SIZE`, in increasing order, and multiples of the pointer size.
  */
-void* allocator_pool_alloc(Allocator_Pool* allocator);
+void allocator_slab_init(Allocator_Slab* allocator, Allocator_Backing backing, const size_t* class_sizes, size_t class_count, size_t retained_empty_slabs);
 
 /**
- * @brief Frees a previously allocated chunk of memory from the pool allocator.
+ * @brief Allocates zero-initialized memory from a slab allocator.
  * 
- * This function takes a pointer to a previously allocated chunk and adds it back to the pool's 
- * free list, making it available for future allocations. It performs bounds checking to ensure the 
- * pointer belongs to the allocator's buffer. If the pointer is `NULL`, no action is taken.
+ * The memory is a chunk of the smallest class holding `size` bytes, or a large object when `size` is 
+ * larger than the largest class.
  * 
- * ### Parameters:
- * - **allocator**: A pointer to the `Allocator_Pool` structure where the chunk should be freed.
- * - **ptr**: A pointer to the chunk that needs to be freed. The pointer must be within the bounds of 
- *           the allocator's buffer.
+ * ### Return:
+ * - **void***: A pointer to the memory, or `NULL` if the backing source failed to provide a slab or 
+ *   the large object.
  * 
- * ### Behavior:
- * 1. If the pointer is `NULL`, the function simply returns without doing anything.
- * 2. The function checks that the pointer lies within the bounds of the allocator's buffer.
- * 3. If the pointer is valid, the function creates a free node from the given chunk and adds it to the 
- *    free list (linked list) of free chunks.
- * 4. The chunk is then available for reallocation.
+ * ### Complexity:
+ * - **Time Complexity**: O(1), plus the backing source when a slab or a large object is requested.
+ */
+void* allocator_slab_alloc(Allocator_Slab* allocator, size_t size);
+
+/**
+ * @brief Frees memory allocated by a slab allocator. If the pointer is `NULL`, no action is taken.
  * 
- * ### Example:
- * ```c
- * void* chunk = allocator_pool_alloc(&pool);
- * allocator_pool_free(&pool, chunk); // Free the chunk once done with it
- * ```
+ * The size is not needed, the class (or the large object) is found from the header of the slab 
+ * holding the pointer. Large objects are given back to the backing source right away.
  * 
  * ### Assertions:
- * - Ensures that the pointer passed to the function is within the bounds of the pool's allocated memory.
- * 
- * ### Notes:
- * - The function does not perform any memory deallocation or zeroing of the chunk. It merely adds it 
- *   back to the free list.
- * - If the pointer is not valid (i.e., not within the pool's memory range), an assertion is triggered.
+ * - Ensures the slab holding the pointer belongs to one of the classes of this allocator, and that a 
+ *   large object is freed through the pointer returned by the allocation.
  * 
  * ### Complexity:
- * - **Time Complexity**: O(1), constant time operation as chunks are simply added to the free list.
- * - **Space Complexity**: O(1), no additional space is required aside from the pointer manipulation.
+ * - **Time Complexity**: O(1).
  */
-void allocator_pool_free(Allocator_Pool* allocator, void* ptr);
+void allocator_slab_free(Allocator_Slab* allocator, void* ptr);
 
 /**
- * @brief Frees all chunks in the pool allocator.
- * 
- * This function marks all the chunks in the pool as free by adding each chunk to the free list, 
- * making all chunks available for future allocations. It effectively resets the pool, allowing 
- * for reuse of the entire buffer.
- * 
- * ### Parameters:
- * - **allocator**: A pointer to the `Allocator_Pool` structure to free all chunks in.
+ * @brief Returns the number of bytes usable at `ptr`: the size of its class, or the requested size of 
+ * a large object.
+ */
+size_t allocator_slab_usable_size(Allocator_Slab* allocator, void* ptr);
+
+/**
+ * @brief Resizes memory allocated by a slab allocator.
  * 
- * ### Behavior:
- * 1. The function calculates the number of chunks based on the pool's buffer length and chunk size.
- * 2. It iterates over all chunks in the pool and adds them to the free list.
- * 3. After calling this function, all chunks are available for reallocation.
+ * The memory stays in place while `new_size` fits in its chunk (or large object), it moves to the 
+ * class of `new_size` otherwise. The bytes added are zeroed.
  * 
- * ### Example:
- * ```c
- * allocator_pool_free_all(&pool); // Free all chunks in the pool
- * ```
+ * ### Return:
+ * - **void***: A pointer to the resized memory, or `NULL` if allocation fails (`old_memory` is then 
+ *   left untouched) or `new_size` is 0 (`old_memory` is then freed).
+ */
+void* allocator_slab_resize(Allocator_Slab* allocator, void* old_memory, size_t old_size, size_t new_size);
+
+/**
+ * @brief Frees every allocation of a slab allocator at once.
  * 
- * ### Notes:
- * - This function does not deallocate any memory; it only marks all chunks as available.
- * - The function operates on the entire pool, effectively resetting its state.
+ * Large objects are given back to the backing source, each class keeps up to `retained_empty_slabs` 
+ * empty slabs as with `allocator_pool_growable_free_all`.
+ */
+void allocator_slab_free_all(Allocator_Slab* allocator);
+
+/**
+ * @brief Gives every slab and large object back to the backing source.
  * 
- * ### Complexity:
- * - **Time Complexity**: O(n), where `n` is the number of chunks in the pool. The function iterates over 
- *   all chunks to add them to the free list.
- * - **Space Complexity**: O(1), no additional space is used, aside from iterating over the chunks.
+ * The allocator stays usable, new slabs are requested by the next allocations.
  */
-void allocator_pool_free_all(Allocator_Pool* allocator);
+void allocator_slab_destroy(Allocator_Slab* allocator);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "allocators.h"
+
+size_t allocator_os_page_size(void) {
+    static size_t page_size = 0;
+
+    if (page_size == 0) {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        page_size = (size_t) info.dwPageSize;
+#else
+        page_size = (size_t) sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+    return page_size;
+}
+
+void* allocator_os_reserve(size_t size) {
+#if defined(_WIN32)
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* ptr = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+#endif
+}
+
+bool allocator_os_commit(void* ptr, size_t size) {
+#if defined(_WIN32)
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void allocator_os_decommit(void* ptr, size_t size) {
+#if defined(_WIN32)
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+#else
+    // The pages are dropped first so the kernel can reclaim them, then made inaccessible again.
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+#endif
+}
+
+void allocator_os_purge(void* ptr, size_t size) {
+#if defined(_WIN32)
+    VirtualAlloc(ptr, size, MEM_RESET, PAGE_READWRITE);
+#else
+    madvise(ptr, size, MADV_DONTNEED);
+#endif
+}
+
+void allocator_os_release(void* ptr, size_t size) {
+#if defined(_WIN32)
+    (void) size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+static void* backing_malloc_alloc(void* user_data, size_t size, size_t align) {
+    (void) user_data;
+
+    if (align < DEFAULT_ALIGNEMENT) {
+        align = DEFAULT_ALIGNEMENT;
+    }
+
+#if defined(_WIN32)
+    return _aligned_malloc(size, align);
+#else
+    // `aligned_alloc` requires the size to be a multiple of the alignment.
+    return aligned_alloc(align, align_forward_size(size, align));
+#endif
+}
+
+static void backing_malloc_free(void* user_data, void* ptr, size_t size) {
+    (void) user_data;
+    (void) size;
+
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+static void* backing_mmap_alloc(void* user_data, size_t size, size_t align) {
+    (void) user_data;
+
+    size_t page_size = allocator_os_page_size();
+    if (align < page_size) {
+        align = page_size;
+    }
+    size = align_forward_size(size, page_size);
+
+    // Over-reserve so an aligned range of `size` bytes always fits, then give back what is around it.
+    size_t    reserve_size = size + align - page_size;
+    uint8_t*  reserved     = (uint8_t*) allocator_os_reserve(reserve_size);
+    if (reserved == NULL) {
+        return NULL;
+    }
+
+    uint8_t* start = (uint8_t*) align_forward_uintptr((uintptr_t) reserved, (uintptr_t) align);
+
+#if defined(_WIN32)
+    // A reservation cannot be partially released on Windows, retry at the aligned address instead.
+    if (start != reserved) {
+        allocator_os_release(reserved, reserve_size);
+        reserved = (uint8_t*) VirtualAlloc(start, size, MEM_RESERVE, PAGE_NOACCESS);
+        if (reserved != start) {
+            return NULL;
+        }
+    }
+#else
+    size_t head = (size_t) (start - reserved);
+    size_t tail = reserve_size - head - size;
+    if (head != 0) {
+        allocator_os_release(reserved, head);
+    }
+    if (tail != 0) {
+        allocator_os_release(start + size, tail);
+    }
+#endif
+
+    if (!allocator_os_commit(start, size)) {
+        allocator_os_release(start, size);
+        return NULL;
+    }
+
+    return start;
+}
+
+static void backing_mmap_free(void* user_data, void* ptr, size_t size) {
+    (void) user_data;
+    allocator_os_release(ptr, align_forward_size(size, allocator_os_page_size()));
+}
+
+const Allocator_Backing ALLOCATOR_BACKING_MALLOC = { backing_malloc_alloc, backing_malloc_free, NULL, false };
+const Allocator_Backing ALLOCATOR_BACKING_MMAP   = { backing_mmap_alloc,   backing_mmap_free,   NULL, true  };
@@ -0,0 +1,281 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+#define BUDDY_WORD_BITS 64
+
+static size_t buddy_word_count(size_t bit_count) {
+    return (bit_count + BUDDY_WORD_BITS - 1) / BUDDY_WORD_BITS;
+}
+
+static inline bool buddy_bit_get(const uint64_t* bits, size_t index) {
+    return (bits[index / BUDDY_WORD_BITS] >> (index % BUDDY_WORD_BITS)) & 1;
+}
+
+static inline void buddy_bit_set(uint64_t* bits, size_t index, bool value) {
+    uint64_t mask = (uint64_t) 1 << (index % BUDDY_WORD_BITS);
+    if (value) {
+        bits[index / BUDDY_WORD_BITS] |= mask;
+    } else {
+        bits[index / BUDDY_WORD_BITS] &= ~mask;
+    }
+}
+
+static inline size_t buddy_block_size(const Allocator_Buddy* allocator, size_t order) {
+    return allocator->min_block_size << order;
+}
+
+/**
+ * Index of the block at `offset` among the blocks of `order`, in the bitmaps of that order.
+ */
+static inline size_t buddy_block_index(const Allocator_Buddy* allocator, size_t offset, size_t order) {
+    return offset >> (allocator->min_block_shift + order);
+}
+
+/**
+ * Whether the block of `order` at `offset` lies entirely in the buffer.
+ */
+static inline bool buddy_block_exists(const Allocator_Buddy* allocator, size_t offset, size_t order) {
+    return offset + buddy_block_size(allocator, order) <= allocator->buf_len;
+}
+
+static void buddy_push(Allocator_Buddy* allocator, size_t offset, size_t order) {
+    Allocator_Buddy_Node* node = (Allocator_Buddy_Node*) &allocator->buf[offset];
+    node->prev = NULL;
+    node->next = allocator->free_lists[order];
+    if (node->next != NULL) {
+        node->next->prev = node;
+    }
+    allocator->free_lists[order] = node;
+
+    buddy_bit_set(allocator->free_bits[order], buddy_block_index(allocator, offset, order), true);
+}
+
+static void buddy_remove(Allocator_Buddy* allocator, size_t offset, size_t order) {
+    Allocator_Buddy_Node* node = (Allocator_Buddy_Node*) &allocator->buf[offset];
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        allocator->free_lists[order] = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+
+    buddy_bit_set(allocator->free_bits[order], buddy_block_index(allocator, offset, order), false);
+}
+
+/**
+ * Smallest order whose blocks hold `size` bytes, or `order_count` if the request is too large.
+ */
+static size_t buddy_order_of_size(const Allocator_Buddy* allocator, size_t size) {
+    size_t order = 0;
+    while (order < allocator->order_count && buddy_block_size(allocator, order) < size) {
+        order += 1;
+    }
+    return order;
+}
+
+/**
+ * Order of the allocated block at `offset`: the largest block containing it which is not split.
+ */
+static size_t buddy_order_of_block(const Allocator_Buddy* allocator, size_t offset) {
+    size_t order = allocator->order_count - 1;
+
+    while (order > 0) {
+        size_t block_offset = offset & ~(buddy_block_size(allocator, order) - 1);
+        if (buddy_block_exists(allocator, block_offset, order) && !buddy_bit_get(allocator->split_bits[order], buddy_block_index(allocator, block_offset, order))) {
+            break;
+        }
+        order -= 1;
+    }
+
+    return order;
+}
+
+/**
+ * Splits the block of `order` at `offset` down to `target_order`, the upper halves go to the free lists.
+ */
+static void buddy_split(Allocator_Buddy* allocator, size_t offset, size_t order, size_t target_order) {
+    while (order > target_order) {
+        buddy_bit_set(allocator->split_bits[order], buddy_block_index(allocator, offset, order), true);
+        order -= 1;
+        buddy_push(allocator, offset + buddy_block_size(allocator, order), order);
+    }
+}
+
+void allocator_buddy_init(Allocator_Buddy* allocator, void* backing_buf, size_t backing_buf_len, size_t min_block_size) {
+    assert(is_power_of_two(min_block_size) && "Minimum block size must be a power of two");
+    assert(min_block_size >= sizeof(Allocator_Buddy_Node) && "Minimum block size is too small");
+
+    allocator->min_block_size  = min_block_size;
+    allocator->min_block_shift = (size_t) __builtin_ctzll((unsigned long long) min_block_size);
+
+    // The bitmaps are stored at the start of the backing buffer, sized for the whole buffer
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t bits_start    = align_forward_uintptr(initial_start, (uintptr_t) sizeof(uint64_t));
+    size_t    max_len       = backing_buf_len > (size_t) (bits_start - initial_start) ? backing_buf_len - (size_t) (bits_start - initial_start) : 0;
+
+    size_t order_count = 0;
+    while (order_count < ALLOCATOR_BUDDY_MAX_ORDERS && (min_block_size << order_count) <= max_len) {
+        order_count += 1;
+    }
+    assert(order_count > 0 && "Backing buffer length is smaller than the minimum block size");
+
+    uint64_t* bits = (uint64_t*) bits_start;
+    for (size_t order = 0; order < order_count; order += 1) {
+        size_t word_count = buddy_word_count(max_len >> (allocator->min_block_shift + order));
+        allocator->free_bits[order]  = bits;
+        allocator->split_bits[order] = bits + word_count;
+        bits += 2 * word_count;
+    }
+
+    // The blocks follow, aligned to the minimum block size
+    uintptr_t start = align_forward_uintptr((uintptr_t) bits, (uintptr_t) min_block_size);
+    assert(start + min_block_size <= initial_start + backing_buf_len && "Backing buffer is too small for the bitmaps and one block");
+
+    allocator->buf       = (uint8_t*) start;
+    allocator->buf_len   = (initial_start + backing_buf_len - start) & ~(min_block_size - 1);
+    allocator->bits_len  = (size_t) ((uint8_t*) bits - (uint8_t*) bits_start);
+
+    // Drop the orders which no longer fit once the bitmaps are carved out
+    while ((min_block_size << (order_count - 1)) > allocator->buf_len) {
+        order_count -= 1;
+    }
+    allocator->order_count = order_count;
+
+    allocator_buddy_free_all(allocator);
+}
+
+void* allocator_buddy_alloc(Allocator_Buddy* allocator, size_t size) {
+    size_t order = buddy_order_of_size(allocator, size);
+    if (order >= allocator->order_count) {
+        return NULL;
+    }
+
+    // Take a block of the smallest order with a free block, split it down to the requested order
+    size_t free_order = order;
+    while (free_order < allocator->order_count && allocator->free_lists[free_order] == NULL) {
+        free_order += 1;
+    }
+    if (free_order == allocator->order_count) {
+        return NULL;
+    }
+
+    size_t offset = (size_t) ((uint8_t*) allocator->free_lists[free_order] - allocator->buf);
+    buddy_remove(allocator, offset, free_order);
+    buddy_split(allocator, offset, free_order, order);
+
+    return memset(&allocator->buf[offset], 0, size);
+}
+
+void allocator_buddy_free(Allocator_Buddy* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    if ((uint8_t*) ptr < allocator->buf || (uint8_t*) ptr >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this buddy allocator");
+        return;
+    }
+
+    size_t offset = (size_t) ((uint8_t*) ptr - allocator->buf);
+    assert((offset & (allocator->min_block_size - 1)) == 0 && "Pointer is not the start of a block");
+
+    size_t order = buddy_order_of_block(allocator, offset);
+    if (buddy_bit_get(allocator->free_bits[order], buddy_block_index(allocator, offset, order))) {
+        assert(0 && "Memory is already free");
+        return;
+    }
+
+    // Merge with the buddy as long as it is entirely free
+    while (order + 1 < allocator->order_count) {
+        size_t buddy = offset ^ buddy_block_size(allocator, order);
+        if (!buddy_block_exists(allocator, buddy, order) || !buddy_bit_get(allocator->free_bits[order], buddy_block_index(allocator, buddy, order))) {
+            break;
+        }
+
+        buddy_remove(allocator, buddy, order);
+        offset  = offset < buddy ? offset : buddy;
+        order  += 1;
+        buddy_bit_set(allocator->split_bits[order], buddy_block_index(allocator, offset, order), false);
+    }
+
+    buddy_push(allocator, offset, order);
+}
+
+void allocator_buddy_free_all(Allocator_Buddy* allocator) {
+    memset(allocator->free_bits[0], 0, allocator->bits_len);
+    for (size_t order = 0; order < ALLOCATOR_BUDDY_MAX_ORDERS; order += 1) {
+        allocator->free_lists[order] = NULL;
+    }
+
+    // Cover the buffer with the largest blocks fitting at each offset, a buffer which is not a power
+    // of two ends with smaller blocks which have no buddy
+    size_t offset = 0;
+    for (size_t order = allocator->order_count; order > 0; order -= 1) {
+        while (buddy_block_exists(allocator, offset, order - 1)) {
+            buddy_push(allocator, offset, order - 1);
+            offset += buddy_block_size(allocator, order - 1);
+        }
+    }
+}
+
+void* allocator_buddy_resize(Allocator_Buddy* allocator, void* old_memory, size_t old_size, size_t new_size) {
+    if (old_memory == NULL) {
+        return allocator_buddy_alloc(allocator, new_size);
+    }
+
+    if ((uint8_t*) old_memory < allocator->buf || (uint8_t*) old_memory >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this buddy allocator");
+        return NULL;
+    }
+
+    if (new_size == 0) {
+        allocator_buddy_free(allocator, old_memory);
+        return NULL;
+    }
+
+    size_t offset    = (size_t) ((uint8_t*) old_memory - allocator->buf);
+    size_t order     = buddy_order_of_block(allocator, offset);
+    size_t new_order = buddy_order_of_size(allocator, new_size);
+
+    if (new_order <= order) {
+        // Shrink in place, the upper halves are given back
+        buddy_split(allocator, offset, order, new_order);
+        if (new_size > old_size) {
+            memset((uint8_t*) old_memory + old_size, 0, new_size - old_size);
+        }
+        return old_memory;
+    }
+
+    // Grow in place when the block is the lower half at each order, and each upper half is free
+    bool in_place = new_order < allocator->order_count;
+    for (size_t k = order; in_place && k < new_order; k += 1) {
+        size_t buddy = offset + buddy_block_size(allocator, k);
+        in_place = (offset & buddy_block_size(allocator, k)) == 0
+            && buddy_block_exists(allocator, buddy, k)
+            && buddy_bit_get(allocator->free_bits[k], buddy_block_index(allocator, buddy, k));
+    }
+
+    if (in_place) {
+        for (size_t k = order; k < new_order; k += 1) {
+            buddy_remove(allocator, offset + buddy_block_size(allocator, k), k);
+            buddy_bit_set(allocator->split_bits[k + 1], buddy_block_index(allocator, offset, k + 1), false);
+        }
+        memset((uint8_t*) old_memory + old_size, 0, new_size - old_size);
+        return old_memory;
+    }
+
+    void* new_memory = allocator_buddy_alloc(allocator, new_size);
+    if (new_memory == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_memory, old_memory, old_size < new_size ? old_size : new_size);
+    allocator_buddy_free(allocator, old_memory);
+
+    return new_memory;
+}
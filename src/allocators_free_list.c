@@ -0,0 +1,305 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+#define FREE_LIST_USED      ((size_t) 1) // The block is allocated
+#define FREE_LIST_PREV_USED ((size_t) 2) // The previous block is allocated, `prev_size` is not valid
+#define FREE_LIST_FLAGS     (FREE_LIST_USED | FREE_LIST_PREV_USED)
+
+#define FREE_LIST_HEADER_SIZE     sizeof(Allocator_Free_List_Header)
+#define FREE_LIST_MIN_BLOCK_SIZE  (FREE_LIST_HEADER_SIZE + sizeof(Allocator_Free_List_Node))
+
+// Blocks are multiples of the default alignment, so the memory right after a header is aligned to it
+_Static_assert(sizeof(Allocator_Free_List_Header) == DEFAULT_ALIGNEMENT, "Free list header must be as large as the default alignment");
+
+static inline size_t free_list_block_size(const Allocator_Free_List_Header* block) {
+    return block->size & ~FREE_LIST_FLAGS;
+}
+
+static inline Allocator_Free_List_Header* free_list_block_at(void* ptr, size_t offset) {
+    return (Allocator_Free_List_Header*) ((uint8_t*) ptr + offset);
+}
+
+static inline Allocator_Free_List_Node* free_list_node_of(Allocator_Free_List_Header* block) {
+    return (Allocator_Free_List_Node*) (block + 1);
+}
+
+static inline Allocator_Free_List_Header* free_list_block_of(Allocator_Free_List_Node* node) {
+    return ((Allocator_Free_List_Header*) node) - 1;
+}
+
+/**
+ * Size of the block holding `data_size` bytes, header included.
+ */
+static size_t free_list_needed_size(size_t data_size) {
+    size_t size = align_forward_size(data_size + FREE_LIST_HEADER_SIZE, DEFAULT_ALIGNEMENT);
+    return size < FREE_LIST_MIN_BLOCK_SIZE ? FREE_LIST_MIN_BLOCK_SIZE : size;
+}
+
+static void free_list_insert(Allocator_Free_List* allocator, Allocator_Free_List_Header* block) {
+    Allocator_Free_List_Node* node = free_list_node_of(block);
+    node->prev = NULL;
+    node->next = allocator->head;
+    if (allocator->head != NULL) {
+        allocator->head->prev = node;
+    }
+    allocator->head = node;
+}
+
+static void free_list_remove(Allocator_Free_List* allocator, Allocator_Free_List_Header* block) {
+    Allocator_Free_List_Node* node = free_list_node_of(block);
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        allocator->head = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+}
+
+/**
+ * Writes the size of a free block in its header and in its boundary tag, in the header of the next block.
+ */
+static void free_list_set_free(Allocator_Free_List_Header* block, size_t size) {
+    block->size = size | (block->size & FREE_LIST_PREV_USED);
+
+    Allocator_Free_List_Header* next = free_list_block_at(block, size);
+    next->prev_size = size;
+    next->size     &= ~FREE_LIST_PREV_USED;
+}
+
+static void free_list_set_used(Allocator_Free_List_Header* block, size_t size) {
+    block->size = size | FREE_LIST_USED | (block->size & FREE_LIST_PREV_USED);
+    free_list_block_at(block, size)->size |= FREE_LIST_PREV_USED;
+}
+
+/**
+ * Gives the end of a used block back, from `size` bytes, if it is large enough to be a block.
+ * The end is merged with the following block when it is free.
+ */
+static void free_list_trim(Allocator_Free_List* allocator, Allocator_Free_List_Header* block, size_t size) {
+    size_t block_size = free_list_block_size(block);
+    if (block_size - size < FREE_LIST_MIN_BLOCK_SIZE) {
+        return;
+    }
+
+    Allocator_Free_List_Header* tail = free_list_block_at(block, size);
+    tail->size = (block_size - size) | FREE_LIST_USED | FREE_LIST_PREV_USED;
+    block->size = size | (block->size & FREE_LIST_FLAGS);
+
+    allocator_free_list_free(allocator, tail + 1);
+}
+
+/**
+ * Offset from the end of the header of `block` to memory aligned to `align`. A gap too small to be
+ * a free block of its own is pushed to the next aligned address past the minimum block size.
+ */
+static size_t free_list_align_gap(Allocator_Free_List_Header* block, size_t align) {
+    uintptr_t data = (uintptr_t) (block + 1);
+    size_t    gap  = (size_t) (align_forward_uintptr(data, (uintptr_t) align) - data);
+
+    if (gap != 0 && gap < FREE_LIST_MIN_BLOCK_SIZE) {
+        gap = (size_t) (align_forward_uintptr(data + FREE_LIST_MIN_BLOCK_SIZE, (uintptr_t) align) - data);
+    }
+
+    return gap;
+}
+
+static Allocator_Free_List_Header* free_list_find(Allocator_Free_List* allocator, size_t needed, size_t align, size_t* gap_out) {
+    Allocator_Free_List_Header* best      = NULL;
+    size_t                      best_size = SIZE_MAX;
+    size_t                      best_gap  = 0;
+
+    for (Allocator_Free_List_Node* node = allocator->head; node != NULL; node = node->next) {
+        Allocator_Free_List_Header* block      = free_list_block_of(node);
+        size_t                      block_size = free_list_block_size(block);
+        size_t                      gap        = align > DEFAULT_ALIGNEMENT ? free_list_align_gap(block, align) : 0;
+
+        if (gap + needed > block_size || block_size >= best_size) {
+            continue;
+        }
+
+        best      = block;
+        best_size = block_size;
+        best_gap  = gap;
+
+        if (allocator->policy == ALLOCATOR_FREE_LIST_FIRST_FIT || block_size == gap + needed) {
+            break;
+        }
+    }
+
+    *gap_out = best_gap;
+    return best;
+}
+
+void allocator_free_list_init(Allocator_Free_List* allocator, void* backing_buf, size_t backing_buf_len) {
+    // Align the backing buffer so the blocks, and the memory following their headers, are aligned
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) DEFAULT_ALIGNEMENT);
+    size_t    padding       = (size_t) (start - initial_start);
+
+    assert(backing_buf_len >= padding + FREE_LIST_MIN_BLOCK_SIZE + FREE_LIST_HEADER_SIZE && "Backing buffer is too small");
+
+    allocator->buf     = (uint8_t*) start;
+    allocator->buf_len = (backing_buf_len - padding) & ~(DEFAULT_ALIGNEMENT - 1);
+    allocator->policy  = ALLOCATOR_FREE_LIST_FIRST_FIT;
+
+    allocator_free_list_free_all(allocator);
+}
+
+void allocator_free_list_set_policy(Allocator_Free_List* allocator, Allocator_Free_List_Policy policy) {
+    allocator->policy = policy;
+}
+
+void* allocator_free_list_alloc_align(Allocator_Free_List* allocator, size_t data_size, size_t data_align) {
+    assert(is_power_of_two(data_align) && "Alignment must be a power of two");
+
+    size_t needed = free_list_needed_size(data_size);
+    size_t gap;
+
+    Allocator_Free_List_Header* block = free_list_find(allocator, needed, data_align, &gap);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    size_t block_size = free_list_block_size(block);
+
+    if (gap != 0) {
+        // The gap stays in the list as a smaller free block, the allocation starts after it
+        free_list_set_free(block, gap);
+        block       = free_list_block_at(block, gap);
+        block->size = block_size - gap;
+        block_size -= gap;
+    } else {
+        free_list_remove(allocator, block);
+    }
+
+    if (block_size - needed >= FREE_LIST_MIN_BLOCK_SIZE) {
+        // Split off the end of the block, it goes back to the list
+        Allocator_Free_List_Header* tail = free_list_block_at(block, needed);
+        tail->size = FREE_LIST_PREV_USED;
+        free_list_set_free(tail, block_size - needed);
+        free_list_insert(allocator, tail);
+
+        block->size = needed | FREE_LIST_USED | (block->size & FREE_LIST_PREV_USED);
+    } else {
+        free_list_set_used(block, block_size);
+    }
+
+    return memset(block + 1, 0, data_size);
+}
+
+void* allocator_free_list_alloc(Allocator_Free_List* allocator, size_t data_size) {
+    return allocator_free_list_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
+void allocator_free_list_free(Allocator_Free_List* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    if ((uint8_t*) ptr < allocator->buf + FREE_LIST_HEADER_SIZE || (uint8_t*) ptr >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this free list allocator");
+        return;
+    }
+
+    Allocator_Free_List_Header* block = ((Allocator_Free_List_Header*) ptr) - 1;
+    if (!(block->size & FREE_LIST_USED)) {
+        assert(0 && "Memory is already free");
+        return;
+    }
+
+    size_t size = free_list_block_size(block);
+
+    // Merge with the following block
+    Allocator_Free_List_Header* next = free_list_block_at(block, size);
+    if (!(next->size & FREE_LIST_USED)) {
+        free_list_remove(allocator, next);
+        size += free_list_block_size(next);
+    }
+
+    // Merge into the previous block, found through its boundary tag. It already is in the list.
+    if (!(block->size & FREE_LIST_PREV_USED)) {
+        Allocator_Free_List_Header* prev = (Allocator_Free_List_Header*) ((uint8_t*) block - block->prev_size);
+        free_list_set_free(prev, free_list_block_size(prev) + size);
+        return;
+    }
+
+    free_list_set_free(block, size);
+    free_list_insert(allocator, block);
+}
+
+void allocator_free_list_free_all(Allocator_Free_List* allocator) {
+    size_t size = allocator->buf_len - FREE_LIST_HEADER_SIZE;
+
+    // The last header is an empty used block, so no merge ever goes past the end of the buffer
+    Allocator_Free_List_Header* end = free_list_block_at(allocator->buf, size);
+    end->size = FREE_LIST_USED;
+
+    Allocator_Free_List_Header* first = (Allocator_Free_List_Header*) allocator->buf;
+    first->prev_size = 0;
+    first->size      = FREE_LIST_PREV_USED;
+    free_list_set_free(first, size);
+
+    allocator->head = NULL;
+    free_list_insert(allocator, first);
+}
+
+void* allocator_free_list_resize_align(Allocator_Free_List* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align) {
+    assert(is_power_of_two(align) && "Alignment must be a power of two");
+
+    if (old_memory == NULL) {
+        return allocator_free_list_alloc_align(allocator, new_size, align);
+    }
+
+    if ((uint8_t*) old_memory < allocator->buf + FREE_LIST_HEADER_SIZE || (uint8_t*) old_memory >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this free list allocator");
+        return NULL;
+    }
+
+    if (new_size == 0) {
+        allocator_free_list_free(allocator, old_memory);
+        return NULL;
+    }
+
+    Allocator_Free_List_Header* block      = ((Allocator_Free_List_Header*) old_memory) - 1;
+    size_t                      block_size = free_list_block_size(block);
+    size_t                      needed     = free_list_needed_size(new_size);
+
+    if (((uintptr_t) old_memory & (align - 1)) == 0) {
+        if (needed > block_size) {
+            // Grow in place by taking the following block, when it is free and large enough
+            Allocator_Free_List_Header* next = free_list_block_at(block, block_size);
+            if (!(next->size & FREE_LIST_USED) && block_size + free_list_block_size(next) >= needed) {
+                free_list_remove(allocator, next);
+                block_size += free_list_block_size(next);
+                free_list_set_used(block, block_size);
+            }
+        }
+
+        if (needed <= block_size) {
+            free_list_trim(allocator, block, needed);
+            if (new_size > old_size) {
+                memset((uint8_t*) old_memory + old_size, 0, new_size - old_size);
+            }
+            return old_memory;
+        }
+    }
+
+    void* new_memory = allocator_free_list_alloc_align(allocator, new_size, align);
+    if (new_memory == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_memory, old_memory, old_size < new_size ? old_size : new_size);
+    allocator_free_list_free(allocator, old_memory);
+
+    return new_memory;
+}
+
+void* allocator_free_list_resize(Allocator_Free_List* allocator, void* old_memory, size_t old_size, size_t new_size) {
+    return allocator_free_list_resize_align(allocator, old_memory, old_size, new_size, DEFAULT_ALIGNEMENT);
+}
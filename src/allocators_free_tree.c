@@ -0,0 +1,502 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+#define FREE_TREE_USED      ((size_t) 1) // The block is allocated
+#define FREE_TREE_PREV_USED ((size_t) 2) // The previous block is allocated, `prev_size` is not valid
+#define FREE_TREE_FLAGS     (FREE_TREE_USED | FREE_TREE_PREV_USED)
+
+#define FREE_TREE_HEADER_SIZE     sizeof(Allocator_Free_List_Header)
+#define FREE_TREE_MIN_BLOCK_SIZE  align_forward_size(FREE_TREE_HEADER_SIZE + sizeof(Allocator_Free_Tree_Node), DEFAULT_ALIGNEMENT)
+
+#define FREE_TREE_RED ((uintptr_t) 1) // Color bit, stored in the low bit of the parent pointer
+
+static inline size_t free_tree_block_size(const Allocator_Free_List_Header* block) {
+    return block->size & ~FREE_TREE_FLAGS;
+}
+
+static inline Allocator_Free_List_Header* free_tree_block_at(void* ptr, size_t offset) {
+    return (Allocator_Free_List_Header*) ((uint8_t*) ptr + offset);
+}
+
+static inline Allocator_Free_Tree_Node* free_tree_node_of(Allocator_Free_List_Header* block) {
+    return (Allocator_Free_Tree_Node*) (block + 1);
+}
+
+static inline Allocator_Free_List_Header* free_tree_block_of(Allocator_Free_Tree_Node* node) {
+    return ((Allocator_Free_List_Header*) node) - 1;
+}
+
+static size_t free_tree_needed_size(size_t data_size) {
+    size_t size = align_forward_size(data_size + FREE_TREE_HEADER_SIZE, DEFAULT_ALIGNEMENT);
+    return size < FREE_TREE_MIN_BLOCK_SIZE ? FREE_TREE_MIN_BLOCK_SIZE : size;
+}
+
+/*
+ * Red-black tree of the free blocks, ordered by size then by address.
+ */
+
+static inline Allocator_Free_Tree_Node* rb_parent(const Allocator_Free_Tree_Node* node) {
+    return (Allocator_Free_Tree_Node*) (node->parent_color & ~FREE_TREE_RED);
+}
+
+static inline bool rb_is_red(const Allocator_Free_Tree_Node* node) {
+    return node != NULL && (node->parent_color & FREE_TREE_RED);
+}
+
+static inline void rb_set_parent(Allocator_Free_Tree_Node* node, Allocator_Free_Tree_Node* parent) {
+    node->parent_color = (uintptr_t) parent | (node->parent_color & FREE_TREE_RED);
+}
+
+static inline void rb_set_red(Allocator_Free_Tree_Node* node, bool red) {
+    node->parent_color = (node->parent_color & ~FREE_TREE_RED) | (red ? FREE_TREE_RED : 0);
+}
+
+static inline bool rb_less(Allocator_Free_Tree_Node* a, Allocator_Free_Tree_Node* b) {
+    size_t a_size = free_tree_block_size(free_tree_block_of(a));
+    size_t b_size = free_tree_block_size(free_tree_block_of(b));
+    return a_size < b_size || (a_size == b_size && (uintptr_t) a < (uintptr_t) b);
+}
+
+static void rb_replace_child(Allocator_Free_Tree* allocator, Allocator_Free_Tree_Node* parent, Allocator_Free_Tree_Node* old_child, Allocator_Free_Tree_Node* new_child) {
+    if (parent == NULL) {
+        allocator->root = new_child;
+    } else if (parent->left == old_child) {
+        parent->left = new_child;
+    } else {
+        parent->right = new_child;
+    }
+}
+
+static void rb_rotate_left(Allocator_Free_Tree* allocator, Allocator_Free_Tree_Node* node) {
+    Allocator_Free_Tree_Node* right  = node->right;
+    Allocator_Free_Tree_Node* parent = rb_parent(node);
+
+    node->right = right->left;
+    if (right->left != NULL) {
+        rb_set_parent(right->left, node);
+    }
+
+    rb_set_parent(right, parent);
+    rb_replace_child(allocator, parent, node, right);
+
+    right->left = node;
+    rb_set_parent(node, right);
+}
+
+static void rb_rotate_right(Allocator_Free_Tree* allocator, Allocator_Free_Tree_Node* node) {
+    Allocator_Free_Tree_Node* left   = node->left;
+    Allocator_Free_Tree_Node* parent = rb_parent(node);
+
+    node->left = left->right;
+    if (left->right != NULL) {
+        rb_set_parent(left->right, node);
+    }
+
+    rb_set_parent(left, parent);
+    rb_replace_child(allocator, parent, node, left);
+
+    left->right = node;
+    rb_set_parent(node, left);
+}
+
+static void free_tree_insert(Allocator_Free_Tree* allocator, Allocator_Free_List_Header* block) {
+    Allocator_Free_Tree_Node* node   = free_tree_node_of(block);
+    Allocator_Free_Tree_Node* parent = NULL;
+    Allocator_Free_Tree_Node* curr   = allocator->root;
+
+    while (curr != NULL) {
+        parent = curr;
+        curr   = rb_less(node, curr) ? curr->left : curr->right;
+    }
+
+    node->left         = NULL;
+    node->right        = NULL;
+    node->parent_color = (uintptr_t) parent | FREE_TREE_RED;
+
+    if (parent == NULL) {
+        allocator->root = node;
+    } else if (rb_less(node, parent)) {
+        parent->left = node;
+    } else {
+        parent->right = node;
+    }
+
+    // Restore the red-black properties: a red node never has a red parent
+    while (rb_is_red(parent = rb_parent(node))) {
+        Allocator_Free_Tree_Node* grandparent = rb_parent(parent);
+
+        if (parent == grandparent->left) {
+            Allocator_Free_Tree_Node* uncle = grandparent->right;
+            if (rb_is_red(uncle)) {
+                rb_set_red(parent, false);
+                rb_set_red(uncle, false);
+                rb_set_red(grandparent, true);
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->right) {
+                rb_rotate_left(allocator, parent);
+                node   = parent;
+                parent = rb_parent(node);
+            }
+            rb_set_red(parent, false);
+            rb_set_red(grandparent, true);
+            rb_rotate_right(allocator, grandparent);
+        } else {
+            Allocator_Free_Tree_Node* uncle = grandparent->left;
+            if (rb_is_red(uncle)) {
+                rb_set_red(parent, false);
+                rb_set_red(uncle, false);
+                rb_set_red(grandparent, true);
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->left) {
+                rb_rotate_right(allocator, parent);
+                node   = parent;
+                parent = rb_parent(node);
+            }
+            rb_set_red(parent, false);
+            rb_set_red(grandparent, true);
+            rb_rotate_left(allocator, grandparent);
+        }
+    }
+
+    rb_set_red(allocator->root, false);
+}
+
+static void free_tree_remove(Allocator_Free_Tree* allocator, Allocator_Free_List_Header* block) {
+    Allocator_Free_Tree_Node* node = free_tree_node_of(block);
+    Allocator_Free_Tree_Node* child;        // Node taking the place of the removed one
+    Allocator_Free_Tree_Node* child_parent; // Its parent, as `child` may be NULL
+    bool                      removed_red;
+
+    if (node->left == NULL || node->right == NULL) {
+        child        = node->left != NULL ? node->left : node->right;
+        child_parent = rb_parent(node);
+        removed_red  = rb_is_red(node);
+
+        rb_replace_child(allocator, child_parent, node, child);
+        if (child != NULL) {
+            rb_set_parent(child, child_parent);
+        }
+    } else {
+        // Two children: the successor (leftmost node of the right subtree) takes the place of the node
+        Allocator_Free_Tree_Node* successor = node->right;
+        while (successor->left != NULL) {
+            successor = successor->left;
+        }
+
+        child       = successor->right;
+        removed_red = rb_is_red(successor);
+
+        if (rb_parent(successor) == node) {
+            child_parent = successor;
+        } else {
+            child_parent = rb_parent(successor);
+            child_parent->left = child;
+            if (child != NULL) {
+                rb_set_parent(child, child_parent);
+            }
+            successor->right = node->right;
+            rb_set_parent(node->right, successor);
+        }
+
+        rb_replace_child(allocator, rb_parent(node), node, successor);
+        successor->parent_color = node->parent_color;
+        successor->left         = node->left;
+        rb_set_parent(node->left, successor);
+    }
+
+    if (removed_red) {
+        return;
+    }
+
+    // A black node was removed: restore the black height on the side of `child`
+    while (child != allocator->root && !rb_is_red(child)) {
+        if (child == child_parent->left) {
+            Allocator_Free_Tree_Node* sibling = child_parent->right;
+            if (rb_is_red(sibling)) {
+                rb_set_red(sibling, false);
+                rb_set_red(child_parent, true);
+                rb_rotate_left(allocator, child_parent);
+                sibling = child_parent->right;
+            }
+            if (!rb_is_red(sibling->left) && !rb_is_red(sibling->right)) {
+                rb_set_red(sibling, true);
+                child        = child_parent;
+                child_parent = rb_parent(child);
+                continue;
+            }
+            if (!rb_is_red(sibling->right)) {
+                rb_set_red(sibling->left, false);
+                rb_set_red(sibling, true);
+                rb_rotate_right(allocator, sibling);
+                sibling = child_parent->right;
+            }
+            rb_set_red(sibling, rb_is_red(child_parent));
+            rb_set_red(child_parent, false);
+            rb_set_red(sibling->right, false);
+            rb_rotate_left(allocator, child_parent);
+        } else {
+            Allocator_Free_Tree_Node* sibling = child_parent->left;
+            if (rb_is_red(sibling)) {
+                rb_set_red(sibling, false);
+                rb_set_red(child_parent, true);
+                rb_rotate_right(allocator, child_parent);
+                sibling = child_parent->left;
+            }
+            if (!rb_is_red(sibling->left) && !rb_is_red(sibling->right)) {
+                rb_set_red(sibling, true);
+                child        = child_parent;
+                child_parent = rb_parent(child);
+                continue;
+            }
+            if (!rb_is_red(sibling->left)) {
+                rb_set_red(sibling->right, false);
+                rb_set_red(sibling, true);
+                rb_rotate_left(allocator, sibling);
+                sibling = child_parent->left;
+            }
+            rb_set_red(sibling, rb_is_red(child_parent));
+            rb_set_red(child_parent, false);
+            rb_set_red(sibling->left, false);
+            rb_rotate_right(allocator, child_parent);
+        }
+        child = allocator->root;
+    }
+
+    if (child != NULL) {
+        rb_set_red(child, false);
+    }
+}
+
+/**
+ * Returns the smallest free block of at least `size` bytes, the lowest one among blocks of the same size.
+ */
+static Allocator_Free_List_Header* free_tree_find(Allocator_Free_Tree* allocator, size_t size) {
+    Allocator_Free_Tree_Node* best = NULL;
+    Allocator_Free_Tree_Node* curr = allocator->root;
+
+    while (curr != NULL) {
+        if (free_tree_block_size(free_tree_block_of(curr)) >= size) {
+            best = curr;
+            curr = curr->left;
+        } else {
+            curr = curr->right;
+        }
+    }
+
+    return best != NULL ? free_tree_block_of(best) : NULL;
+}
+
+/*
+ * Blocks, with the same layout and boundary tags as `Allocator_Free_List`.
+ */
+
+static void free_tree_set_free(Allocator_Free_List_Header* block, size_t size) {
+    block->size = size | (block->size & FREE_TREE_PREV_USED);
+
+    Allocator_Free_List_Header* next = free_tree_block_at(block, size);
+    next->prev_size = size;
+    next->size     &= ~FREE_TREE_PREV_USED;
+}
+
+static void free_tree_set_used(Allocator_Free_List_Header* block, size_t size) {
+    block->size = size | FREE_TREE_USED | (block->size & FREE_TREE_PREV_USED);
+    free_tree_block_at(block, size)->size |= FREE_TREE_PREV_USED;
+}
+
+static void free_tree_trim(Allocator_Free_Tree* allocator, Allocator_Free_List_Header* block, size_t size) {
+    size_t block_size = free_tree_block_size(block);
+    if (block_size - size < FREE_TREE_MIN_BLOCK_SIZE) {
+        return;
+    }
+
+    Allocator_Free_List_Header* tail = free_tree_block_at(block, size);
+    tail->size = (block_size - size) | FREE_TREE_USED | FREE_TREE_PREV_USED;
+    block->size = size | (block->size & FREE_TREE_FLAGS);
+
+    allocator_free_tree_free(allocator, tail + 1);
+}
+
+void allocator_free_tree_init(Allocator_Free_Tree* allocator, void* backing_buf, size_t backing_buf_len) {
+    // Align the backing buffer so the blocks, and the memory following their headers, are aligned
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) DEFAULT_ALIGNEMENT);
+    size_t    padding       = (size_t) (start - initial_start);
+
+    assert(backing_buf_len >= padding + FREE_TREE_MIN_BLOCK_SIZE + FREE_TREE_HEADER_SIZE && "Backing buffer is too small");
+
+    allocator->buf     = (uint8_t*) start;
+    allocator->buf_len = (backing_buf_len - padding) & ~(DEFAULT_ALIGNEMENT - 1);
+
+    allocator_free_tree_free_all(allocator);
+}
+
+void* allocator_free_tree_alloc_align(Allocator_Free_Tree* allocator, size_t data_size, size_t data_align) {
+    assert(is_power_of_two(data_align) && "Alignment must be a power of two");
+
+    size_t needed = free_tree_needed_size(data_size);
+
+    // A larger alignment may need a gap in front of the allocation, search for a block fitting the largest one
+    size_t search = needed;
+    if (data_align > DEFAULT_ALIGNEMENT) {
+        search += data_align + FREE_TREE_MIN_BLOCK_SIZE;
+    }
+
+    Allocator_Free_List_Header* block = free_tree_find(allocator, search);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    free_tree_remove(allocator, block);
+    size_t block_size = free_tree_block_size(block);
+
+    if (data_align > DEFAULT_ALIGNEMENT) {
+        uintptr_t data = (uintptr_t) (block + 1);
+        size_t    gap  = (size_t) (align_forward_uintptr(data, (uintptr_t) data_align) - data);
+        if (gap != 0 && gap < FREE_TREE_MIN_BLOCK_SIZE) {
+            gap = (size_t) (align_forward_uintptr(data + FREE_TREE_MIN_BLOCK_SIZE, (uintptr_t) data_align) - data);
+        }
+
+        if (gap != 0) {
+            // The gap goes back to the tree as a smaller free block, the allocation starts after it
+            free_tree_set_free(block, gap);
+            free_tree_insert(allocator, block);
+            block       = free_tree_block_at(block, gap);
+            block->size = block_size - gap;
+            block_size -= gap;
+        }
+    }
+
+    if (block_size - needed >= FREE_TREE_MIN_BLOCK_SIZE) {
+        // Split off the end of the block, it goes back to the tree
+        Allocator_Free_List_Header* tail = free_tree_block_at(block, needed);
+        tail->size = FREE_TREE_PREV_USED;
+        free_tree_set_free(tail, block_size - needed);
+        free_tree_insert(allocator, tail);
+
+        block->size = needed | FREE_TREE_USED | (block->size & FREE_TREE_PREV_USED);
+    } else {
+        free_tree_set_used(block, block_size);
+    }
+
+    return memset(block + 1, 0, data_size);
+}
+
+void* allocator_free_tree_alloc(Allocator_Free_Tree* allocator, size_t data_size) {
+    return allocator_free_tree_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
+void allocator_free_tree_free(Allocator_Free_Tree* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    if ((uint8_t*) ptr < allocator->buf + FREE_TREE_HEADER_SIZE || (uint8_t*) ptr >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this free tree allocator");
+        return;
+    }
+
+    Allocator_Free_List_Header* block = ((Allocator_Free_List_Header*) ptr) - 1;
+    if (!(block->size & FREE_TREE_USED)) {
+        assert(0 && "Memory is already free");
+        return;
+    }
+
+    size_t size = free_tree_block_size(block);
+
+    // Merge with the following block
+    Allocator_Free_List_Header* next = free_tree_block_at(block, size);
+    if (!(next->size & FREE_TREE_USED)) {
+        free_tree_remove(allocator, next);
+        size += free_tree_block_size(next);
+    }
+
+    // Merge into the previous block, found through its boundary tag. Its size changes, so it is reinserted.
+    if (!(block->size & FREE_TREE_PREV_USED)) {
+        Allocator_Free_List_Header* prev = (Allocator_Free_List_Header*) ((uint8_t*) block - block->prev_size);
+        free_tree_remove(allocator, prev);
+        size += free_tree_block_size(prev);
+        block = prev;
+    }
+
+    free_tree_set_free(block, size);
+    free_tree_insert(allocator, block);
+}
+
+void allocator_free_tree_free_all(Allocator_Free_Tree* allocator) {
+    size_t size = allocator->buf_len - FREE_TREE_HEADER_SIZE;
+
+    // The last header is an empty used block, so no merge ever goes past the end of the buffer
+    Allocator_Free_List_Header* end = free_tree_block_at(allocator->buf, size);
+    end->size = FREE_TREE_USED;
+
+    Allocator_Free_List_Header* first = (Allocator_Free_List_Header*) allocator->buf;
+    first->prev_size = 0;
+    first->size      = FREE_TREE_PREV_USED;
+    free_tree_set_free(first, size);
+
+    allocator->root = NULL;
+    free_tree_insert(allocator, first);
+}
+
+void* allocator_free_tree_resize_align(Allocator_Free_Tree* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align) {
+    assert(is_power_of_two(align) && "Alignment must be a power of two");
+
+    if (old_memory == NULL) {
+        return allocator_free_tree_alloc_align(allocator, new_size, align);
+    }
+
+    if ((uint8_t*) old_memory < allocator->buf + FREE_TREE_HEADER_SIZE || (uint8_t*) old_memory >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this free tree allocator");
+        return NULL;
+    }
+
+    if (new_size == 0) {
+        allocator_free_tree_free(allocator, old_memory);
+        return NULL;
+    }
+
+    Allocator_Free_List_Header* block      = ((Allocator_Free_List_Header*) old_memory) - 1;
+    size_t                      block_size = free_tree_block_size(block);
+    size_t                      needed     = free_tree_needed_size(new_size);
+
+    if (((uintptr_t) old_memory & (align - 1)) == 0) {
+        if (needed > block_size) {
+            // Grow in place by taking the following block, when it is free and large enough
+            Allocator_Free_List_Header* next = free_tree_block_at(block, block_size);
+            if (!(next->size & FREE_TREE_USED) && block_size + free_tree_block_size(next) >= needed) {
+                free_tree_remove(allocator, next);
+                block_size += free_tree_block_size(next);
+                free_tree_set_used(block, block_size);
+            }
+        }
+
+        if (needed <= block_size) {
+            free_tree_trim(allocator, block, needed);
+            if (new_size > old_size) {
+                memset((uint8_t*) old_memory + old_size, 0, new_size - old_size);
+            }
+            return old_memory;
+        }
+    }
+
+    void* new_memory = allocator_free_tree_alloc_align(allocator, new_size, align);
+    if (new_memory == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_memory, old_memory, old_size < new_size ? old_size : new_size);
+    allocator_free_tree_free(allocator, old_memory);
+
+    return new_memory;
+}
+
+void* allocator_free_tree_resize(Allocator_Free_Tree* allocator, void* old_memory, size_t old_size, size_t new_size) {
+    return allocator_free_tree_resize_align(allocator, old_memory, old_size, new_size, DEFAULT_ALIGNEMENT);
+}
@@ -9,9 +9,42 @@ void allocator_linear_init(Allocator_Linear* allocator, void* backing_buf, size_
     allocator->buf_len     = backing_buf_len;
     allocator->prev_offset = 0;
     allocator->curr_offset = 0;
+
+    // Nothing is known about the content of the buffer, all of it is considered dirty.
+    allocator->zero_policy  = ALLOCATOR_ZERO_ALWAYS;
+    allocator->dirty_offset = backing_buf_len;
 }
 
-void* allocator_linear_alloc_align(Allocator_Linear* allocator, size_t data_size, size_t data_align) {
+void allocator_linear_set_zero_policy(Allocator_Linear* allocator, Allocator_Zero_Policy zero_policy) {
+    allocator->zero_policy = zero_policy;
+}
+
+/**
+ * Clears the `size` bytes at `offset` according to the zeroing policy of the allocator.
+ * With `ALLOCATOR_ZERO_LAZY`, only the bytes under the dirty high-water mark are cleared.
+ */
+static void linear_zero(Allocator_Linear* allocator, size_t offset, size_t size) {
+    size_t end = offset + size;
+
+    switch (allocator->zero_policy) {
+        case ALLOCATOR_ZERO_ALWAYS:
+            memset(&allocator->buf[offset], 0, size);
+            break;
+        case ALLOCATOR_ZERO_NEVER:
+            break;
+        case ALLOCATOR_ZERO_LAZY:
+            if (offset < allocator->dirty_offset) {
+                memset(&allocator->buf[offset], 0, (end < allocator->dirty_offset ? end : allocator->dirty_offset) - offset);
+            }
+            break;
+    }
+
+    if (end > allocator->dirty_offset) {
+        allocator->dirty_offset = end;
+    }
+}
+
+static void* linear_alloc_align(Allocator_Linear* allocator, size_t data_size, size_t data_align, bool zero) {
     // Align 'curr_offset' forward to the specified alignment
     uintptr_t curr_ptr = (uintptr_t) allocator->buf + (uintptr_t) allocator->curr_offset;
     uintptr_t offset = align_forward_uintptr(curr_ptr, (uintptr_t) data_align);
@@ -22,7 +55,12 @@ void* allocator_linear_alloc_align(Allocator_Linear* allocator, size_t data_size
         void* ptr = &allocator->buf[offset];
         allocator->prev_offset = offset;
         allocator->curr_offset = offset + data_size;
-        memset(ptr, 0, data_size);
+        if (zero) {
+            linear_zero(allocator, offset, data_size);
+        } else if (offset + data_size > allocator->dirty_offset) {
+            // The caller is about to write there, the bytes can no longer be assumed to be zero.
+            allocator->dirty_offset = offset + data_size;
+        }
         return ptr;
     }
 
@@ -30,10 +68,22 @@ void* allocator_linear_alloc_align(Allocator_Linear* allocator, size_t data_size
 	return NULL;
 }
 
+void* allocator_linear_alloc_align(Allocator_Linear* allocator, size_t data_size, size_t data_align) {
+    return linear_alloc_align(allocator, data_size, data_align, true);
+}
+
 void* allocator_linear_alloc(Allocator_Linear* allocator, size_t data_size) {
     return allocator_linear_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
 }
 
+void* allocator_linear_alloc_align_no_zero(Allocator_Linear* allocator, size_t data_size, size_t data_align) {
+    return linear_alloc_align(allocator, data_size, data_align, false);
+}
+
+void* allocator_linear_alloc_no_zero(Allocator_Linear* allocator, size_t data_size) {
+    return allocator_linear_alloc_align_no_zero(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
 void allocator_linear_free(Allocator_Linear* allocator) {
     allocator->prev_offset = 0;
     allocator->curr_offset = 0;
@@ -48,12 +98,12 @@ void* allocator_linear_resize_align(Allocator_Linear* allocator, void* old_memor
         // Allocation of a new block inside the buffer.
         return allocator_linear_alloc_align(allocator, new_size, align);
     } else if (allocator->buf <= old_mem && old_mem < allocator->buf + allocator->buf_len) {
-        if (allocator->buf + allocator->prev_offset == old_mem) {
+        if (allocator->buf + allocator->prev_offset == old_mem && allocator->prev_offset + new_size <= allocator->buf_len) {
             // If the allocation to resize is the last one, the resize is done in place.
             allocator->curr_offset = allocator->prev_offset + new_size;
             if (new_size > old_size) {
                 // Is the memory block grow, the new bytes are set to 0 by default.
-                memset(&allocator->buf[allocator->curr_offset], 0, new_size - old_size);
+                linear_zero(allocator, allocator->prev_offset + old_size, new_size - old_size);
             }
 
             return old_memory;
@@ -62,7 +112,9 @@ void* allocator_linear_resize_align(Allocator_Linear* allocator, void* old_memor
             // block allocated at the end of the buffer grown of shrinked depending on the new size.
             void* new_memory = allocator_linear_alloc_align(allocator, new_size, align);
             size_t copy_size = old_size < new_size ? old_size : new_size;
-            memmove(new_memory, old_memory, old_size);
+            if (new_memory != NULL) {
+                memmove(new_memory, old_memory, copy_size);
+            }
             return new_memory;
         }
     }  else {
@@ -77,4 +129,324 @@ void* allocator_linear_resize_align(Allocator_Linear* allocator, void* old_memor
 
 void* allocator_linear_resize(Allocator_Linear* allocator, void* old_memory, size_t old_size, size_t new_size) {
     return allocator_linear_resize_align(allocator, old_memory, old_size, new_size, DEFAULT_ALIGNEMENT);
-}
\ No newline at end of file
+}
+
+Allocator_Linear_Temp allocator_linear_temp_begin(Allocator_Linear* allocator) {
+    Allocator_Linear_Temp temp;
+    temp.allocator   = allocator;
+    temp.prev_offset = allocator->prev_offset;
+    temp.curr_offset = allocator->curr_offset;
+    return temp;
+}
+
+void allocator_linear_temp_end(Allocator_Linear_Temp* temp) {
+    Allocator_Linear* allocator = temp->allocator;
+    if (allocator == NULL) {
+        return;
+    }
+
+    assert(temp->curr_offset <= allocator->curr_offset && "Linear allocator checkpoints ended out of order");
+
+    allocator->prev_offset = temp->prev_offset;
+    allocator->curr_offset = temp->curr_offset;
+}
+
+/**
+ * Size of the `Allocator_Linear_Block` header, rounded up so the usable part of a block starts aligned.
+ */
+#define LINEAR_BLOCK_HEADER_SIZE align_forward_size(sizeof(Allocator_Linear_Block), DEFAULT_ALIGNEMENT)
+
+static void linear_growable_use_block(Allocator_Linear_Growable* allocator, Allocator_Linear_Block* block) {
+    Allocator_Zero_Policy zero_policy = allocator->linear.zero_policy;
+
+    // Remember how much of the block being left was handed out, for the lazy zeroing policy.
+    if (allocator->block != NULL) {
+        allocator->block->dirty_offset = allocator->linear.dirty_offset;
+    }
+
+    allocator->block = block;
+    allocator_linear_init(&allocator->linear, (uint8_t*) block + LINEAR_BLOCK_HEADER_SIZE, block->size - LINEAR_BLOCK_HEADER_SIZE);
+    allocator->linear.zero_policy  = zero_policy;
+    allocator->linear.dirty_offset = block->dirty_offset;
+}
+
+/**
+ * Moves the allocator to a block able to hold `data_size` bytes aligned to `data_align`.
+ * The next cached block is reused when it is large enough, otherwise a new block is requested
+ * from the backing source and inserted right after the current one.
+ */
+static bool linear_growable_next_block(Allocator_Linear_Growable* allocator, size_t data_size, size_t data_align) {
+    // Worst case: the whole alignment padding is needed in front of the data.
+    size_t needed = LINEAR_BLOCK_HEADER_SIZE + data_size + (data_align > DEFAULT_ALIGNEMENT ? data_align - 1 : 0);
+
+    Allocator_Linear_Block* curr = allocator->block;
+    Allocator_Linear_Block* next = curr != NULL ? curr->next : allocator->first;
+
+    if (next != NULL && next->size >= needed) {
+        linear_growable_use_block(allocator, next);
+        return true;
+    }
+
+    size_t block_size = allocator->block_size < needed ? needed : allocator->block_size;
+    Allocator_Linear_Block* block = (Allocator_Linear_Block*) allocator->backing.alloc(allocator->backing.user_data, block_size, DEFAULT_ALIGNEMENT);
+    if (block == NULL) {
+        return false;
+    }
+
+    block->size         = block_size;
+    block->dirty_offset = allocator->backing.zero_filled ? 0 : block_size - LINEAR_BLOCK_HEADER_SIZE;
+    block->prev         = curr;
+    block->next = next;
+    if (next != NULL) {
+        next->prev = block;
+    }
+    if (curr != NULL) {
+        curr->next = block;
+    } else {
+        allocator->first = block;
+    }
+
+    // Geometric growth, so the number of blocks stays logarithmic in the total allocated size.
+    if (allocator->block_size < allocator->block_size_max) {
+        allocator->block_size *= ALLOCATOR_LINEAR_GROWTH_FACTOR;
+        if (allocator->block_size > allocator->block_size_max) {
+            allocator->block_size = allocator->block_size_max;
+        }
+    }
+
+    linear_growable_use_block(allocator, block);
+    return true;
+}
+
+void allocator_linear_growable_init(Allocator_Linear_Growable* allocator, Allocator_Backing backing, size_t block_size, size_t cached_block_count) {
+    assert(block_size > LINEAR_BLOCK_HEADER_SIZE && "Block size is too small");
+
+    allocator->first              = NULL;
+    allocator->block              = NULL;
+    allocator->backing            = backing;
+    allocator->block_size         = block_size;
+    allocator->block_size_max     = block_size > ALLOCATOR_LINEAR_BLOCK_SIZE_MAX ? block_size : ALLOCATOR_LINEAR_BLOCK_SIZE_MAX;
+    allocator->cached_block_count = cached_block_count;
+
+    // No block yet, the first allocation chains one.
+    allocator_linear_init(&allocator->linear, NULL, 0);
+    allocator->linear.zero_policy = ALLOCATOR_ZERO_LAZY;
+}
+
+void* allocator_linear_growable_alloc_align(Allocator_Linear_Growable* allocator, size_t data_size, size_t data_align) {
+    if (allocator->block != NULL) {
+        void* ptr = allocator_linear_alloc_align(&allocator->linear, data_size, data_align);
+        if (ptr != NULL) {
+            return ptr;
+        }
+    }
+
+    // The current block is full (or there is none yet), move to the next one.
+    if (!linear_growable_next_block(allocator, data_size, data_align)) {
+        return NULL;
+    }
+
+    return allocator_linear_alloc_align(&allocator->linear, data_size, data_align);
+}
+
+void* allocator_linear_growable_alloc(Allocator_Linear_Growable* allocator, size_t data_size) {
+    return allocator_linear_growable_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
+void allocator_linear_growable_free(Allocator_Linear_Growable* allocator) {
+    Allocator_Linear_Block* first = allocator->first;
+    if (first == NULL) {
+        return;
+    }
+
+    // Keep the first block and up to `cached_block_count` blocks after it, give the others back.
+    Allocator_Linear_Block* last_kept = first;
+    for (size_t i = 0; i < allocator->cached_block_count && last_kept->next != NULL; i += 1) {
+        last_kept = last_kept->next;
+    }
+
+    // Save the dirty high-water mark of the current block before it is possibly released.
+    allocator->block->dirty_offset = allocator->linear.dirty_offset;
+    allocator->block = NULL;
+
+    Allocator_Linear_Block* block = last_kept->next;
+    last_kept->next = NULL;
+    while (block != NULL) {
+        Allocator_Linear_Block* next = block->next;
+        allocator->backing.free(allocator->backing.user_data, block, block->size);
+        block = next;
+    }
+
+    linear_growable_use_block(allocator, first);
+}
+
+void allocator_linear_growable_destroy(Allocator_Linear_Growable* allocator) {
+    Allocator_Linear_Block* block = allocator->first;
+    while (block != NULL) {
+        Allocator_Linear_Block* next = block->next;
+        allocator->backing.free(allocator->backing.user_data, block, block->size);
+        block = next;
+    }
+
+    Allocator_Zero_Policy zero_policy = allocator->linear.zero_policy;
+
+    allocator->first = NULL;
+    allocator->block = NULL;
+    allocator_linear_init(&allocator->linear, NULL, 0);
+    allocator->linear.zero_policy = zero_policy;
+}
+
+void* allocator_linear_growable_resize_align(Allocator_Linear_Growable* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align) {
+    Allocator_Linear* linear = &allocator->linear;
+    uint8_t* old_mem = (uint8_t*) old_memory;
+
+    assert(is_power_of_two(align));
+
+    if (old_mem == NULL || old_size == 0) {
+        return allocator_linear_growable_alloc_align(allocator, new_size, align);
+    }
+
+    if (allocator->block != NULL && linear->buf + linear->prev_offset == old_mem && linear->prev_offset + new_size <= linear->buf_len) {
+        // Last allocation of the current block with enough room left, resized in place.
+        return allocator_linear_resize_align(linear, old_memory, old_size, new_size, align);
+    }
+
+    // The block lives in an older block, or the current one is too small: move it.
+    void* new_memory = allocator_linear_growable_alloc_align(allocator, new_size, align);
+    if (new_memory != NULL) {
+        memmove(new_memory, old_memory, old_size < new_size ? old_size : new_size);
+    }
+    return new_memory;
+}
+
+void* allocator_linear_growable_resize(Allocator_Linear_Growable* allocator, void* old_memory, size_t old_size, size_t new_size) {
+    return allocator_linear_growable_resize_align(allocator, old_memory, old_size, new_size, DEFAULT_ALIGNEMENT);
+}
+
+/**
+ * Commits the pages of a virtual linear allocator up to at least `end_offset`, by whole granules.
+ */
+static bool linear_virtual_commit(Allocator_Linear_Virtual* allocator, size_t end_offset) {
+    Allocator_Linear* linear = &allocator->linear;
+
+    if (end_offset <= linear->buf_len) {
+        return true;
+    }
+    if (end_offset > allocator->reserve_len) {
+        return false;
+    }
+
+    size_t commit_end = align_forward_size(end_offset, allocator->commit_granule);
+    if (commit_end > allocator->reserve_len) {
+        commit_end = allocator->reserve_len;
+    }
+
+    if (!allocator_os_commit(linear->buf + linear->buf_len, commit_end - linear->buf_len)) {
+        return false;
+    }
+
+    linear->buf_len = commit_end;
+    return true;
+}
+
+bool allocator_linear_virtual_init(Allocator_Linear_Virtual* allocator, size_t reserve_size, size_t commit_granule) {
+    size_t page_size = allocator_os_page_size();
+
+    assert(is_power_of_two(commit_granule) && "Commit granule must be a power of two");
+
+    allocator->commit_granule = commit_granule < page_size ? page_size : commit_granule;
+    allocator->reserve_len    = align_forward_size(reserve_size, allocator->commit_granule);
+
+    void* reserved = allocator_os_reserve(allocator->reserve_len);
+    if (reserved == NULL) {
+        allocator->reserve_len = 0;
+        allocator_linear_init(&allocator->linear, NULL, 0);
+        return false;
+    }
+
+    // Nothing is committed yet, `linear.buf_len` grows with the committed range.
+    // Committed pages come zero-filled from the OS, so they only need to be cleared once they were handed out.
+    allocator_linear_init(&allocator->linear, reserved, 0);
+    allocator->linear.zero_policy = ALLOCATOR_ZERO_LAZY;
+    return true;
+}
+
+void allocator_linear_virtual_destroy(Allocator_Linear_Virtual* allocator) {
+    if (allocator->linear.buf != NULL) {
+        allocator_os_release(allocator->linear.buf, allocator->reserve_len);
+    }
+
+    allocator->reserve_len = 0;
+    allocator_linear_init(&allocator->linear, NULL, 0);
+}
+
+void* allocator_linear_virtual_alloc_align(Allocator_Linear_Virtual* allocator, size_t data_size, size_t data_align) {
+    void* ptr = allocator_linear_alloc_align(&allocator->linear, data_size, data_align);
+    if (ptr != NULL) {
+        return ptr;
+    }
+
+    // Not enough committed memory: commit the granules the aligned request crosses, then retry.
+    Allocator_Linear* linear = &allocator->linear;
+    uintptr_t curr_ptr = (uintptr_t) linear->buf + (uintptr_t) linear->curr_offset;
+    size_t    offset   = (size_t) (align_forward_uintptr(curr_ptr, (uintptr_t) data_align) - (uintptr_t) linear->buf);
+
+    if (offset > allocator->reserve_len || data_size > allocator->reserve_len - offset || !linear_virtual_commit(allocator, offset + data_size)) {
+        return NULL;
+    }
+
+    return allocator_linear_alloc_align(linear, data_size, data_align);
+}
+
+void* allocator_linear_virtual_alloc(Allocator_Linear_Virtual* allocator, size_t data_size) {
+    return allocator_linear_virtual_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
+void allocator_linear_virtual_free(Allocator_Linear_Virtual* allocator, size_t keep_committed) {
+    Allocator_Linear* linear = &allocator->linear;
+
+    allocator_linear_free(linear);
+
+    // Checked before rounding, which would wrap `SIZE_MAX` to 0 and decommit everything.
+    if (keep_committed >= linear->buf_len) {
+        return;
+    }
+
+    size_t keep_len = align_forward_size(keep_committed, allocator->commit_granule);
+    if (keep_len < linear->buf_len) {
+        allocator_os_decommit(linear->buf + keep_len, linear->buf_len - keep_len);
+        linear->buf_len = keep_len;
+
+        // Decommitted pages read as zero once committed again.
+        if (linear->dirty_offset > keep_len) {
+            linear->dirty_offset = keep_len;
+        }
+    }
+}
+
+void* allocator_linear_virtual_resize_align(Allocator_Linear_Virtual* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align) {
+    Allocator_Linear* linear = &allocator->linear;
+    uint8_t* old_mem = (uint8_t*) old_memory;
+
+    if (old_mem == NULL || old_size == 0) {
+        return allocator_linear_virtual_alloc_align(allocator, new_size, align);
+    }
+
+    if (linear->buf + linear->prev_offset == old_mem) {
+        // The last allocation always grows in place, as long as the reserved range is large enough.
+        if (new_size > allocator->reserve_len - linear->prev_offset || !linear_virtual_commit(allocator, linear->prev_offset + new_size)) {
+            return NULL;
+        }
+        return allocator_linear_resize_align(linear, old_memory, old_size, new_size, align);
+    }
+
+    void* new_memory = allocator_linear_virtual_alloc_align(allocator, new_size, align);
+    if (new_memory != NULL) {
+        memmove(new_memory, old_memory, old_size < new_size ? old_size : new_size);
+    }
+    return new_memory;
+}
+
+void* allocator_linear_virtual_resize(Allocator_Linear_Virtual* allocator, void* old_memory, size_t old_size, size_t new_size) {
+    return allocator_linear_virtual_resize_align(allocator, old_memory, old_size, new_size, DEFAULT_ALIGNEMENT);
+}
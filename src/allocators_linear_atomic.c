@@ -0,0 +1,138 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+void allocator_linear_atomic_init(Allocator_Linear_Atomic* allocator, void* backing_buf, size_t backing_buf_len) {
+    // Align the start of the buffer, so aligning offsets is the same as aligning addresses.
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) DEFAULT_ALIGNEMENT);
+
+    assert(backing_buf_len >= (size_t) (start - initial_start) && "Backing buffer is too small");
+
+    allocator->buf     = (uint8_t*) start;
+    allocator->buf_len = backing_buf_len - (size_t) (start - initial_start);
+    atomic_init(&allocator->curr_offset, 0);
+    atomic_init(&allocator->epoch, 0);
+}
+
+static void* linear_atomic_alloc_align(Allocator_Linear_Atomic* allocator, size_t data_size, size_t data_align) {
+    assert(is_power_of_two(data_align));
+
+    // `curr_offset` always stays a multiple of the default alignment, by rounding every size up to it.
+    size_t size = align_forward_size(data_size, DEFAULT_ALIGNEMENT);
+    size_t curr = atomic_load_explicit(&allocator->curr_offset, memory_order_relaxed);
+
+    if (data_align <= DEFAULT_ALIGNEMENT) {
+        // Fast path: no padding is ever needed, a single fetch-add reserves the memory.
+        // The pre-check keeps a request which obviously does not fit from pushing the offset past the end.
+        if (curr > allocator->buf_len || size > allocator->buf_len - curr) {
+            return NULL;
+        }
+
+        size_t offset = atomic_fetch_add_explicit(&allocator->curr_offset, size, memory_order_relaxed);
+        if (offset > allocator->buf_len || size > allocator->buf_len - offset) {
+            // Lost a race for the last bytes of the buffer, the arena is exhausted.
+            return NULL;
+        }
+
+        return &allocator->buf[offset];
+    }
+
+    // Padding depends on the offset, reserve with a CAS loop so the padding is computed on the offset actually taken.
+    for (;;) {
+        if (curr > allocator->buf_len) {
+            return NULL;
+        }
+
+        size_t offset = align_forward_size(curr, data_align);
+        if (offset > allocator->buf_len || size > allocator->buf_len - offset) {
+            return NULL;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&allocator->curr_offset, &curr, offset + size, memory_order_relaxed, memory_order_relaxed)) {
+            return &allocator->buf[offset];
+        }
+    }
+}
+
+void* allocator_linear_atomic_alloc_align(Allocator_Linear_Atomic* allocator, size_t data_size, size_t data_align) {
+    void* ptr = linear_atomic_alloc_align(allocator, data_size, data_align);
+    if (ptr != NULL) {
+        memset(ptr, 0, data_size);
+    }
+    return ptr;
+}
+
+void* allocator_linear_atomic_alloc(Allocator_Linear_Atomic* allocator, size_t data_size) {
+    return allocator_linear_atomic_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
+void* allocator_linear_atomic_alloc_align_no_zero(Allocator_Linear_Atomic* allocator, size_t data_size, size_t data_align) {
+    return linear_atomic_alloc_align(allocator, data_size, data_align);
+}
+
+void* allocator_linear_atomic_alloc_no_zero(Allocator_Linear_Atomic* allocator, size_t data_size) {
+    return allocator_linear_atomic_alloc_align_no_zero(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
+void allocator_linear_atomic_free(Allocator_Linear_Atomic* allocator) {
+    atomic_store_explicit(&allocator->curr_offset, 0, memory_order_relaxed);
+
+    // Invalidates the slices every TLAB took from the previous epoch.
+    atomic_fetch_add_explicit(&allocator->epoch, 1, memory_order_relaxed);
+}
+
+void allocator_linear_tlab_init(Allocator_Linear_Tlab* allocator, Allocator_Linear_Atomic* shared, size_t slice_size) {
+    assert(slice_size > 0 && "Slice size must not be zero");
+
+    allocator->shared     = shared;
+    allocator->slice_size = align_forward_size(slice_size, DEFAULT_ALIGNEMENT);
+    allocator->epoch      = atomic_load_explicit(&shared->epoch, memory_order_relaxed);
+
+    // No slice yet, the first allocation takes one.
+    allocator_linear_init(&allocator->linear, NULL, 0);
+}
+
+/**
+ * Slow path of the TLAB allocation: the slice is exhausted or belongs to a previous epoch of the shared arena.
+ */
+static void* linear_tlab_refill(Allocator_Linear_Tlab* allocator, size_t data_size, size_t data_align) {
+    Allocator_Linear_Atomic* shared = allocator->shared;
+
+    // Large requests would waste most of a slice, they are served by the shared arena directly.
+    if (data_size + data_align > allocator->slice_size / 2) {
+        return allocator_linear_atomic_alloc_align(shared, data_size, data_align);
+    }
+
+    size_t epoch = atomic_load_explicit(&shared->epoch, memory_order_relaxed);
+    void*  slice = allocator_linear_atomic_alloc_align_no_zero(shared, allocator->slice_size, DEFAULT_ALIGNEMENT);
+    if (slice == NULL) {
+        // Not enough room left for a whole slice, the request itself may still fit.
+        return allocator_linear_atomic_alloc_align(shared, data_size, data_align);
+    }
+
+    Allocator_Zero_Policy zero_policy = allocator->linear.zero_policy;
+    allocator_linear_init(&allocator->linear, slice, allocator->slice_size);
+    allocator->linear.zero_policy = zero_policy;
+    allocator->epoch              = epoch;
+
+    return allocator_linear_alloc_align(&allocator->linear, data_size, data_align);
+}
+
+void* allocator_linear_tlab_alloc_align(Allocator_Linear_Tlab* allocator, size_t data_size, size_t data_align) {
+    if (allocator->epoch == atomic_load_explicit(&allocator->shared->epoch, memory_order_relaxed)) {
+        void* ptr = allocator_linear_alloc_align(&allocator->linear, data_size, data_align);
+        if (ptr != NULL) {
+            return ptr;
+        }
+    }
+
+    return linear_tlab_refill(allocator, data_size, data_align);
+}
+
+void* allocator_linear_tlab_alloc(Allocator_Linear_Tlab* allocator, size_t data_size) {
+    return allocator_linear_tlab_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
@@ -4,10 +4,58 @@
 
 #include "allocators.h"
 
-void allocator_pool_init(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+#define POOL_LIVE_WORD_BITS 64
+
+/**
+ * Sets or clears the occupancy bit of the chunk at `ptr`, when the pool tracks its live chunks.
+ * Returns whether the bit was set before.
+ */
+static bool pool_mark_live(Allocator_Pool* allocator, void* ptr, bool live) {
+	if (allocator->live_bits == NULL) {
+		return !live;
+	}
+
+	size_t    index = (size_t) ((uint8_t*) ptr - allocator->buf) / allocator->chunk_size;
+	uint64_t* word  = &allocator->live_bits[index / POOL_LIVE_WORD_BITS];
+	uint64_t  bit   = (uint64_t) 1 << (index % POOL_LIVE_WORD_BITS);
+	bool      was   = (*word & bit) != 0;
+
+	if (live) {
+		*word |= bit;
+	} else {
+		*word &= ~bit;
+	}
+
+	return was;
+}
+
+/**
+ * Sets the occupancy bits of the `count` chunks starting at the chunk `first`, a word at a time,
+ * when the pool tracks its live chunks.
+ */
+static void pool_mark_live_run(Allocator_Pool* allocator, size_t first, size_t count) {
+	if (allocator->live_bits == NULL) {
+		return;
+	}
+
+	size_t end = first + count;
+	for (size_t index = first; index < end;) {
+		size_t   shift = index % POOL_LIVE_WORD_BITS;
+		size_t   bits  = POOL_LIVE_WORD_BITS - shift < end - index ? POOL_LIVE_WORD_BITS - shift : end - index;
+		uint64_t mask  = bits == POOL_LIVE_WORD_BITS ? ~(uint64_t) 0 : (((uint64_t) 1 << bits) - 1) << shift;
+
+		allocator->live_bits[index / POOL_LIVE_WORD_BITS] |= mask;
+		index += bits;
+	}
+}
+
+static void pool_init(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align, bool lazy) {
+	assert(is_power_of_two(chunk_align) && "Chunk alignment must be a power of two");
+
 	// Align backing buffer to the specified chunk alignment
 	uintptr_t initial_start = (uintptr_t) backing_buf;
 	uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) chunk_align);
+	assert(backing_buf_len > (size_t) (start-initial_start) && "Backing buffer is too small for the chunk alignment");
 	backing_buf_len        -= (size_t) (start-initial_start);
 
     // Align chunk size up to the required chunk alignment
@@ -18,28 +66,67 @@ void allocator_pool_init(Allocator_Pool* allocator, void* backing_buf, size_t ba
 	assert(backing_buf_len >= chunk_size && "Backing buffer length is smaller than the chunk size");
 
 	// Store the adjusted parameters
-	allocator->buf            = (uint8_t*) backing_buf;
+	allocator->buf            = (uint8_t*) start;
 	allocator->buf_len        = backing_buf_len;
 	allocator->chunk_size     = chunk_size;
 	allocator->free_list_head = NULL;
+	allocator->unused_offset  = 0;
+	allocator->lazy           = lazy;
+	allocator->live_bits      = NULL;
 
 	// Set up the free list for free chunks
 	allocator_pool_free_all(allocator);
 }
 
+void allocator_pool_init(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+	pool_init(allocator, backing_buf, backing_buf_len, chunk_size, chunk_align, false);
+}
+
+void allocator_pool_init_lazy(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+	pool_init(allocator, backing_buf, backing_buf_len, chunk_size, chunk_align, true);
+}
+
+void allocator_pool_init_tracked(Allocator_Pool* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+	// The occupancy bitmap is stored at the start of the backing buffer, sized for the most chunks the buffer could hold
+	uintptr_t initial_start = (uintptr_t) backing_buf;
+	uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) sizeof(uint64_t));
+	size_t    max_chunks    = backing_buf_len / align_forward_size(chunk_size, chunk_align);
+	size_t    bitmap_len    = (max_chunks + POOL_LIVE_WORD_BITS - 1) / POOL_LIVE_WORD_BITS * sizeof(uint64_t);
+	assert(backing_buf_len > (size_t) (start - initial_start) + bitmap_len && "Backing buffer is too small");
+
+	uint8_t* chunks = (uint8_t*) start + bitmap_len;
+	pool_init(allocator, chunks, backing_buf_len - (size_t) (chunks - (uint8_t*) backing_buf), chunk_size, chunk_align, true);
+
+	allocator->live_bits = (uint64_t*) start;
+	memset(allocator->live_bits, 0, bitmap_len);
+}
+
 void* allocator_pool_alloc(Allocator_Pool* allocator) {
 	Allocator_Pool_Free_Node* free_node = allocator->free_list_head;
 	
 	if(free_node == NULL) {
+		// No freed chunk to reuse, take the next one never handed out (lazy mode)
+		if (allocator->unused_offset + allocator->chunk_size <= allocator->buf_len) {
+			void* ptr = &allocator->buf[allocator->unused_offset];
+			allocator->unused_offset += allocator->chunk_size;
+			pool_mark_live(allocator, ptr, true);
+			return memset(ptr, 0, allocator->chunk_size);
+		}
+
 		assert(0 && "Pool allocator has no free memory");
 		return NULL;
 	}
 
 	allocator->free_list_head = allocator->free_list_head->next;
+	pool_mark_live(allocator, free_node, true);
 
 	return memset(free_node, 0, allocator->chunk_size);
 }
 
+bool allocator_pool_has_free_chunk(const Allocator_Pool* allocator) {
+	return allocator->free_list_head != NULL || allocator->unused_offset + allocator->chunk_size <= allocator->buf_len;
+}
+
 void allocator_pool_free(Allocator_Pool* allocator, void* ptr) {
 	if (ptr == NULL) {
 		return;
@@ -50,26 +137,485 @@ void allocator_pool_free(Allocator_Pool* allocator, void* ptr) {
 	void* start = allocator->buf;
 	void* end = &allocator->buf[allocator->buf_len];
 
-	if (ptr < start || ptr > end) {
+	if (ptr < start || ptr >= end) {
 		assert(0 && "Memory is out of bounds of the buffer in this pool");
 		return;
 	}
 
+	assert((size_t) ((uint8_t*) ptr - allocator->buf) % allocator->chunk_size == 0 && "Pointer is not the start of a chunk");
+
+	if (!pool_mark_live(allocator, ptr, false)) {
+		assert(0 && "Chunk is already free");
+		return;
+	}
+
 	free_node = (Allocator_Pool_Free_Node*) ptr;
 	free_node->next = allocator->free_list_head;
 	allocator->free_list_head = free_node;
 }
 
+static size_t pool_alloc_n(Allocator_Pool* allocator, void** out, size_t n, bool zero) {
+	size_t count = 0;
+
+	// Unlink a run of nodes from the free list in a single walk, the head is only updated once
+	Allocator_Pool_Free_Node* node = allocator->free_list_head;
+	while (count < n && node != NULL) {
+		Allocator_Pool_Free_Node* next = node->next;
+
+		out[count] = node;
+		pool_mark_live(allocator, node, true);
+		if (zero) {
+			memset(node, 0, allocator->chunk_size);
+		}
+
+		node = next;
+		count += 1;
+	}
+	allocator->free_list_head = node;
+
+	// Then take the chunks never handed out as one contiguous block, cleared and marked live at once
+	size_t unused_count = 0;
+	if (allocator->unused_offset < allocator->buf_len) {
+		unused_count = (allocator->buf_len - allocator->unused_offset) / allocator->chunk_size;
+	}
+	if (unused_count > n - count) {
+		unused_count = n - count;
+	}
+
+	if (unused_count > 0) {
+		uint8_t* first = &allocator->buf[allocator->unused_offset];
+		if (zero) {
+			memset(first, 0, unused_count * allocator->chunk_size);
+		}
+		pool_mark_live_run(allocator, allocator->unused_offset / allocator->chunk_size, unused_count);
+		for (size_t i = 0; i < unused_count; i += 1) {
+			out[count + i] = first + i * allocator->chunk_size;
+		}
+		allocator->unused_offset += unused_count * allocator->chunk_size;
+		count += unused_count;
+	}
+
+	return count;
+}
+
+size_t allocator_pool_alloc_n(Allocator_Pool* allocator, void** out, size_t n) {
+	return pool_alloc_n(allocator, out, n, true);
+}
+
+size_t allocator_pool_alloc_n_no_zero(Allocator_Pool* allocator, void** out, size_t n) {
+	return pool_alloc_n(allocator, out, n, false);
+}
+
+void allocator_pool_free_n(Allocator_Pool* allocator, void** ptrs, size_t n) {
+	uint8_t* start = allocator->buf;
+	uint8_t* end   = &allocator->buf[allocator->buf_len];
+
+	// Chain the chunks together, then splice the whole chain in front of the free list at once
+	Allocator_Pool_Free_Node* first = NULL;
+	Allocator_Pool_Free_Node* last  = NULL;
+
+	for (size_t i = 0; i < n; i += 1) {
+		uint8_t* ptr = (uint8_t*) ptrs[i];
+		if (ptr == NULL) {
+			continue;
+		}
+
+		if (ptr < start || ptr >= end) {
+			assert(0 && "Memory is out of bounds of the buffer in this pool");
+			continue;
+		}
+
+		assert((size_t) (ptr - start) % allocator->chunk_size == 0 && "Pointer is not the start of a chunk");
+
+		if (!pool_mark_live(allocator, ptr, false)) {
+			assert(0 && "Chunk is already free");
+			continue;
+		}
+
+		Allocator_Pool_Free_Node* node = (Allocator_Pool_Free_Node*) ptr;
+		if (last != NULL) {
+			last->next = node;
+		} else {
+			first = node;
+		}
+		last = node;
+	}
+
+	if (first != NULL) {
+		last->next = allocator->free_list_head;
+		allocator->free_list_head = first;
+	}
+}
+
 void allocator_pool_free_all(Allocator_Pool* allocator) {
+    allocator->free_list_head = NULL;
+
+    if (allocator->live_bits != NULL) {
+        size_t chunk_count = allocator->buf_len / allocator->chunk_size;
+        memset(allocator->live_bits, 0, (chunk_count + POOL_LIVE_WORD_BITS - 1) / POOL_LIVE_WORD_BITS * sizeof(uint64_t));
+    }
+
+    if (allocator->lazy) {
+        // Every chunk is "never handed out" again, they are bump-allocated before the free list is used
+        allocator->unused_offset = 0;
+        return;
+    }
+
     size_t chunk_count = allocator->buf_len / allocator->chunk_size;
+    allocator->unused_offset = chunk_count * allocator->chunk_size;
 
-	// Set all chunks to be free
-    for(size_t i = 0; i < chunk_count; i += 1) {
-        void* ptr = &allocator->buf[i * allocator->chunk_size];
+	// Set all chunks to be free, pushed from the last one so the list is in ascending address order
+    for(size_t i = chunk_count; i > 0; i -= 1) {
+        void* ptr = &allocator->buf[(i - 1) * allocator->chunk_size];
         Allocator_Pool_Free_Node* free_node = (Allocator_Pool_Free_Node*) ptr;
 
 		// Push free node onto the free list
         free_node->next = allocator->free_list_head;
         allocator->free_list_head = free_node;
     }
-}
\ No newline at end of file
+}
+
+size_t allocator_pool_next_live(const Allocator_Pool* allocator, size_t index) {
+	size_t chunk_count = allocator->buf_len / allocator->chunk_size;
+
+	if (allocator->live_bits == NULL) {
+		assert(0 && "Pool does not track its live chunks, see allocator_pool_init_tracked");
+		return chunk_count;
+	}
+
+	// No chunk past the watermark was ever handed out, the scan stops there
+	size_t end = allocator->unused_offset / allocator->chunk_size;
+	if (index >= end) {
+		return chunk_count;
+	}
+
+	size_t   word_index = index / POOL_LIVE_WORD_BITS;
+	size_t   word_end   = (end + POOL_LIVE_WORD_BITS - 1) / POOL_LIVE_WORD_BITS;
+	uint64_t live       = allocator->live_bits[word_index] & (~(uint64_t) 0 << (index % POOL_LIVE_WORD_BITS));
+
+	for (;;) {
+		if (live != 0) {
+			return word_index * POOL_LIVE_WORD_BITS + (size_t) __builtin_ctzll(live);
+		}
+
+		word_index += 1;
+		if (word_index >= word_end) {
+			return chunk_count;
+		}
+		live = allocator->live_bits[word_index];
+	}
+}
+
+/**
+ * Merges two lists sorted by address into one.
+ */
+static Allocator_Pool_Free_Node* pool_free_list_merge(Allocator_Pool_Free_Node* a, Allocator_Pool_Free_Node* b) {
+	Allocator_Pool_Free_Node  head;
+	Allocator_Pool_Free_Node* tail = &head;
+
+	while (a != NULL && b != NULL) {
+		if ((uintptr_t) a < (uintptr_t) b) {
+			tail->next = a;
+			a = a->next;
+		} else {
+			tail->next = b;
+			b = b->next;
+		}
+		tail = tail->next;
+	}
+	tail->next = a != NULL ? a : b;
+
+	return head.next;
+}
+
+void allocator_pool_sort_free_list(Allocator_Pool* allocator) {
+	if (allocator->live_bits != NULL) {
+		// The free chunks are known from the bitmap, push them from the highest address
+		Allocator_Pool_Free_Node* head = NULL;
+		for (size_t i = allocator->unused_offset / allocator->chunk_size; i > 0; i -= 1) {
+			if ((allocator->live_bits[(i - 1) / POOL_LIVE_WORD_BITS] >> ((i - 1) % POOL_LIVE_WORD_BITS)) & 1) {
+				continue;
+			}
+			Allocator_Pool_Free_Node* node = (Allocator_Pool_Free_Node*) &allocator->buf[(i - 1) * allocator->chunk_size];
+			node->next = head;
+			head = node;
+		}
+		allocator->free_list_head = head;
+		return;
+	}
+
+	// Bottom-up merge sort with a binary counter of sorted runs: `pending[i]` holds a run of 2^i nodes.
+	// Each node is merged into the small runs right away, while they are still in the cache, instead
+	// of walking the whole list once per run length.
+	Allocator_Pool_Free_Node* pending[64] = { NULL };
+	Allocator_Pool_Free_Node* list        = allocator->free_list_head;
+
+	while (list != NULL) {
+		Allocator_Pool_Free_Node* run = list;
+		list      = list->next;
+		run->next = NULL;
+
+		size_t i = 0;
+		while (pending[i] != NULL) {
+			run = pool_free_list_merge(pending[i], run);
+			pending[i] = NULL;
+			i += 1;
+		}
+		pending[i] = run;
+	}
+
+	for (size_t i = 0; i < 64; i += 1) {
+		list = pool_free_list_merge(pending[i], list);
+	}
+
+	allocator->free_list_head = list;
+}
+
+size_t allocator_pool_compact(Allocator_Pool* allocator, Allocator_Pool_Relocate_Fn relocate, void* user_data) {
+	if (allocator->live_bits == NULL) {
+		assert(0 && "Pool does not track its live chunks, see allocator_pool_init_tracked");
+		return 0;
+	}
+
+	size_t chunk_count = allocator->buf_len / allocator->chunk_size;
+	size_t end         = allocator->unused_offset / allocator->chunk_size;
+	size_t moved       = 0;
+
+	// Two fingers: `hole` goes up through the free chunks, `last` goes down through the live ones
+	size_t hole = 0;
+	size_t last = end;
+	for (;;) {
+		while (hole < last && (allocator->live_bits[hole / POOL_LIVE_WORD_BITS] >> (hole % POOL_LIVE_WORD_BITS)) & 1) {
+			hole += 1;
+		}
+		while (last > hole && !((allocator->live_bits[(last - 1) / POOL_LIVE_WORD_BITS] >> ((last - 1) % POOL_LIVE_WORD_BITS)) & 1)) {
+			last -= 1;
+		}
+		if (hole >= last) {
+			break;
+		}
+
+		uint8_t* old_ptr = &allocator->buf[(last - 1) * allocator->chunk_size];
+		uint8_t* new_ptr = &allocator->buf[hole * allocator->chunk_size];
+		memcpy(new_ptr, old_ptr, allocator->chunk_size);
+		pool_mark_live(allocator, new_ptr, true);
+		pool_mark_live(allocator, old_ptr, false);
+		relocate(user_data, old_ptr, new_ptr);
+
+		moved += 1;
+		last  -= 1;
+	}
+
+	// The live chunks are [0, last), everything after them becomes a single never handed out region
+	allocator->free_list_head = NULL;
+	allocator->unused_offset  = (last < chunk_count ? last : chunk_count) * allocator->chunk_size;
+
+	return moved;
+}
+
+void allocator_pool_purge_unused(Allocator_Pool* allocator) {
+	if (!allocator->lazy) {
+		return;
+	}
+
+	size_t    page_size = allocator_os_page_size();
+	uintptr_t start     = align_forward_uintptr((uintptr_t) &allocator->buf[allocator->unused_offset], (uintptr_t) page_size);
+	uintptr_t end       = ((uintptr_t) &allocator->buf[allocator->buf_len]) & ~((uintptr_t) page_size - 1);
+
+	if (start < end) {
+		allocator_os_purge((void*) start, (size_t) (end - start));
+	}
+}
+
+static void pool_slab_unlink(Allocator_Pool_Slab** list, Allocator_Pool_Slab* slab) {
+    if (slab->prev != NULL) {
+        slab->prev->next = slab->next;
+    } else {
+        *list = slab->next;
+    }
+    if (slab->next != NULL) {
+        slab->next->prev = slab->prev;
+    }
+    slab->prev = NULL;
+    slab->next = NULL;
+}
+
+static void pool_slab_push(Allocator_Pool_Slab** list, Allocator_Pool_Slab* slab) {
+    slab->prev = NULL;
+    slab->next = *list;
+    if (*list != NULL) {
+        (*list)->prev = slab;
+    }
+    *list = slab;
+}
+
+static Allocator_Pool_Slab* pool_growable_slab_create(Allocator_Pool_Growable* allocator) {
+    Allocator_Pool_Slab* slab = (Allocator_Pool_Slab*) allocator->backing.alloc(allocator->backing.user_data, allocator->slab_size, allocator->slab_size);
+    if (slab == NULL) {
+        return NULL;
+    }
+
+    // Chunks start right after the header, which is padded to keep them aligned
+    size_t header_size = align_forward_size(sizeof(Allocator_Pool_Slab), allocator->chunk_align);
+
+    // Then shifted by the color of the slab, taken from the bytes which would be left over at the end
+    size_t color = 0;
+    if (allocator->color_step != 0) {
+        size_t left_over = (allocator->slab_size - header_size) % align_forward_size(allocator->chunk_size, allocator->chunk_align);
+
+        color = allocator->color_next <= left_over ? allocator->color_next : 0;
+        allocator->color_next = color + allocator->color_step <= left_over ? color + allocator->color_step : 0;
+    }
+
+    allocator_pool_init_lazy(&slab->pool, (uint8_t*) slab + header_size + color, allocator->slab_size - header_size - color, allocator->chunk_size, allocator->chunk_align);
+
+    slab->owner       = allocator;
+    slab->used_count  = 0;
+    slab->chunk_count = slab->pool.buf_len / slab->pool.chunk_size;
+    slab->prev        = NULL;
+    slab->next        = NULL;
+
+    allocator->empty_slab_count += 1;
+    return slab;
+}
+
+static void pool_growable_slab_release(Allocator_Pool_Growable* allocator, Allocator_Pool_Slab* slab) {
+    allocator->backing.free(allocator->backing.user_data, slab, allocator->slab_size);
+}
+
+void allocator_pool_growable_init(Allocator_Pool_Growable* allocator, Allocator_Backing backing, size_t slab_size, size_t chunk_size, size_t chunk_align, size_t retained_empty_slabs) {
+    assert(is_power_of_two(slab_size) && "Slab size must be a power of two");
+    assert(is_power_of_two(chunk_align) && "Chunk alignment must be a power of two");
+    assert(align_forward_size(sizeof(Allocator_Pool_Slab), chunk_align) + align_forward_size(chunk_size, chunk_align) <= slab_size && "Slab size is too small for a single chunk");
+
+    allocator->partial_slabs        = NULL;
+    allocator->full_slabs           = NULL;
+    allocator->backing              = backing;
+    allocator->slab_size            = slab_size;
+    allocator->chunk_size           = chunk_size;
+    allocator->chunk_align          = chunk_align;
+    allocator->empty_slab_count     = 0;
+    allocator->retained_empty_slabs = retained_empty_slabs;
+    allocator->color_step           = 0;
+    allocator->color_next           = 0;
+}
+
+void allocator_pool_growable_set_coloring(Allocator_Pool_Growable* allocator, size_t color_step) {
+    assert((color_step == 0 || (is_power_of_two(color_step) && color_step % allocator->chunk_align == 0)) && "Color step must be a power of two and a multiple of the chunk alignment");
+
+    allocator->color_step = color_step;
+    allocator->color_next = 0;
+}
+
+void* allocator_pool_growable_alloc(Allocator_Pool_Growable* allocator) {
+    Allocator_Pool_Slab* slab = allocator->partial_slabs;
+
+    if (slab == NULL) {
+        slab = pool_growable_slab_create(allocator);
+        if (slab == NULL) {
+            return NULL;
+        }
+        pool_slab_push(&allocator->partial_slabs, slab);
+    }
+
+    if (slab->used_count == 0) {
+        allocator->empty_slab_count -= 1;
+    }
+
+    slab->used_count += 1;
+    if (slab->used_count == slab->chunk_count) {
+        // The slab is full, it no longer needs to be looked at by allocations
+        pool_slab_unlink(&allocator->partial_slabs, slab);
+        pool_slab_push(&allocator->full_slabs, slab);
+    }
+
+    return allocator_pool_alloc(&slab->pool);
+}
+
+void allocator_pool_growable_free(Allocator_Pool_Growable* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    // Slabs are aligned to their size, the header is found from any of their chunks
+    Allocator_Pool_Slab* slab = allocator_pool_slab_of(ptr, allocator->slab_size);
+    assert(slab->owner == allocator && "Memory does not belong to this growable pool");
+
+    allocator_pool_free(&slab->pool, ptr);
+
+    if (slab->used_count == slab->chunk_count) {
+        pool_slab_unlink(&allocator->full_slabs, slab);
+        pool_slab_push(&allocator->partial_slabs, slab);
+    }
+
+    slab->used_count -= 1;
+    if (slab->used_count == 0) {
+        allocator->empty_slab_count += 1;
+
+        if (allocator->empty_slab_count > allocator->retained_empty_slabs) {
+            pool_slab_unlink(&allocator->partial_slabs, slab);
+            pool_growable_slab_release(allocator, slab);
+            allocator->empty_slab_count -= 1;
+        }
+    }
+}
+
+void allocator_pool_growable_free_all(Allocator_Pool_Growable* allocator) {
+    // Every slab becomes empty, move them all to the partial list
+    while (allocator->full_slabs != NULL) {
+        Allocator_Pool_Slab* slab = allocator->full_slabs;
+        pool_slab_unlink(&allocator->full_slabs, slab);
+        pool_slab_push(&allocator->partial_slabs, slab);
+    }
+
+    allocator->empty_slab_count = 0;
+
+    Allocator_Pool_Slab* slab = allocator->partial_slabs;
+    while (slab != NULL) {
+        Allocator_Pool_Slab* next = slab->next;
+
+        if (allocator->empty_slab_count < allocator->retained_empty_slabs) {
+            allocator_pool_free_all(&slab->pool);
+            slab->used_count = 0;
+            allocator->empty_slab_count += 1;
+        } else {
+            pool_slab_unlink(&allocator->partial_slabs, slab);
+            pool_growable_slab_release(allocator, slab);
+        }
+
+        slab = next;
+    }
+}
+
+void allocator_pool_growable_destroy(Allocator_Pool_Growable* allocator) {
+    Allocator_Pool_Slab* lists[2] = { allocator->partial_slabs, allocator->full_slabs };
+
+    for (size_t i = 0; i < 2; i += 1) {
+        Allocator_Pool_Slab* slab = lists[i];
+        while (slab != NULL) {
+            Allocator_Pool_Slab* next = slab->next;
+            pool_growable_slab_release(allocator, slab);
+            slab = next;
+        }
+    }
+
+    allocator->partial_slabs    = NULL;
+    allocator->full_slabs       = NULL;
+    allocator->empty_slab_count = 0;
+}
+
+bool allocator_pool_growable_owns(Allocator_Pool_Growable* allocator, void* ptr) {
+    // The slab header of a foreign pointer may not be mapped, only the known slabs are compared
+    Allocator_Pool_Slab* candidate = allocator_pool_slab_of(ptr, allocator->slab_size);
+    Allocator_Pool_Slab* lists[2]  = { allocator->partial_slabs, allocator->full_slabs };
+
+    for (size_t i = 0; i < 2; i += 1) {
+        for (Allocator_Pool_Slab* slab = lists[i]; slab != NULL; slab = slab->next) {
+            if (slab == candidate) {
+                return (uint8_t*) ptr >= slab->pool.buf && (uint8_t*) ptr < slab->pool.buf + slab->pool.buf_len;
+            }
+        }
+    }
+
+    return false;
+}
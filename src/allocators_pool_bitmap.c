@@ -0,0 +1,182 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "allocators.h"
+
+#define BITMAP_WORD_BITS 64
+
+static size_t bitmap_word_count(size_t bit_count) {
+    return (bit_count + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+}
+
+/**
+ * Bytes needed in front of the chunks for the two levels of bitmaps of `chunk_count` chunks.
+ */
+static size_t pool_bitmap_overhead(size_t chunk_count) {
+    size_t word_count = bitmap_word_count(chunk_count);
+    return (word_count + bitmap_word_count(word_count)) * sizeof(uint64_t);
+}
+
+/**
+ * Returns the index of the first non-zero word of `words` in [start, count), or `count` if there is none.
+ * Runs of zero words (full parts of the pool) are skipped 4 words at a time with AVX2 when available.
+ */
+static size_t bitmap_find_nonzero(const uint64_t* words, size_t start, size_t count) {
+    size_t i = start;
+
+#if defined(__AVX2__)
+    for (; i + 4 <= count; i += 4) {
+        __m256i block = _mm256_loadu_si256((const __m256i*) &words[i]);
+        if (!_mm256_testz_si256(block, block)) {
+            break;
+        }
+    }
+#endif
+
+    for (; i < count; i += 1) {
+        if (words[i] != 0) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+void allocator_pool_bitmap_init(Allocator_Pool_Bitmap* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+    assert(chunk_size > 0 && "Chunk size must not be 0");
+    assert(is_power_of_two(chunk_align) && "Chunk alignment must be a power of two");
+
+    // The bitmaps are stored at the start of the backing buffer, aligned for 64 bits words
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) sizeof(uint64_t));
+    assert(backing_buf_len > (size_t) (start - initial_start) && "Backing buffer is too small");
+    backing_buf_len -= (size_t) (start - initial_start);
+
+    chunk_size = align_forward_size(chunk_size, chunk_align);
+
+    // Find how many chunks fit next to their own bitmaps (and the padding to align the first chunk)
+    size_t chunk_count = backing_buf_len / chunk_size;
+    while (chunk_count > 0) {
+        size_t needed = pool_bitmap_overhead(chunk_count) + (chunk_align - 1) + chunk_count * chunk_size;
+        if (needed <= backing_buf_len) {
+            break;
+        }
+        size_t excess = needed - backing_buf_len;
+        chunk_count -= excess / chunk_size > 0 ? excess / chunk_size : 1;
+    }
+
+    assert(chunk_count > 0 && "Backing buffer length is smaller than the chunk size");
+
+    allocator->word_count    = bitmap_word_count(chunk_count);
+    allocator->summary_count = bitmap_word_count(allocator->word_count);
+    allocator->free_bits     = (uint64_t*) start;
+    allocator->summary_bits  = allocator->free_bits + allocator->word_count;
+    allocator->buf           = (uint8_t*) align_forward_uintptr((uintptr_t) (allocator->summary_bits + allocator->summary_count), (uintptr_t) chunk_align);
+    allocator->chunk_size    = chunk_size;
+    allocator->chunk_count   = chunk_count;
+
+    allocator_pool_bitmap_free_all(allocator);
+}
+
+void* allocator_pool_bitmap_alloc(Allocator_Pool_Bitmap* allocator) {
+    // Every summary word before the hint is known to be zero
+    size_t summary_index = bitmap_find_nonzero(allocator->summary_bits, allocator->search_hint, allocator->summary_count);
+    if (summary_index == allocator->summary_count) {
+        assert(0 && "Pool allocator has no free memory");
+        return NULL;
+    }
+
+    uint64_t summary    = allocator->summary_bits[summary_index];
+    size_t   word_index = summary_index * BITMAP_WORD_BITS + (size_t) __builtin_ctzll(summary);
+    uint64_t word       = allocator->free_bits[word_index];
+    size_t   index      = word_index * BITMAP_WORD_BITS + (size_t) __builtin_ctzll(word);
+
+    // Clear the lowest set bit, and the summary bit once the word has no free chunk left
+    word &= word - 1;
+    allocator->free_bits[word_index] = word;
+    if (word == 0) {
+        allocator->summary_bits[summary_index] = summary & (summary - 1);
+    }
+
+    allocator->search_hint = summary_index;
+
+    return memset(&allocator->buf[index * allocator->chunk_size], 0, allocator->chunk_size);
+}
+
+void allocator_pool_bitmap_free(Allocator_Pool_Bitmap* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    uintptr_t start = (uintptr_t) allocator->buf;
+    uintptr_t addr  = (uintptr_t) ptr;
+
+    if (addr < start || addr >= start + allocator->chunk_count * allocator->chunk_size) {
+        assert(0 && "Memory is out of bounds of the buffer in this pool");
+        return;
+    }
+
+    size_t index = (size_t) (addr - start) / allocator->chunk_size;
+    assert(index * allocator->chunk_size == (size_t) (addr - start) && "Pointer is not the start of a chunk");
+
+    size_t   word_index    = index / BITMAP_WORD_BITS;
+    size_t   summary_index = word_index / BITMAP_WORD_BITS;
+    uint64_t bit           = (uint64_t) 1 << (index % BITMAP_WORD_BITS);
+
+    if (allocator->free_bits[word_index] & bit) {
+        assert(0 && "Double free in bitmap pool");
+        return;
+    }
+
+    // The chunk itself is not written, freed memory stays cold
+    allocator->free_bits[word_index]       |= bit;
+    allocator->summary_bits[summary_index] |= (uint64_t) 1 << (word_index % BITMAP_WORD_BITS);
+
+    if (summary_index < allocator->search_hint) {
+        allocator->search_hint = summary_index;
+    }
+}
+
+void allocator_pool_bitmap_free_all(Allocator_Pool_Bitmap* allocator) {
+    size_t tail_bits = allocator->chunk_count % BITMAP_WORD_BITS;
+    memset(allocator->free_bits, 0xFF, allocator->word_count * sizeof(uint64_t));
+    if (tail_bits != 0) {
+        // Bits past the last chunk are never free
+        allocator->free_bits[allocator->word_count - 1] = ((uint64_t) 1 << tail_bits) - 1;
+    }
+
+    size_t summary_tail_bits = allocator->word_count % BITMAP_WORD_BITS;
+    memset(allocator->summary_bits, 0xFF, allocator->summary_count * sizeof(uint64_t));
+    if (summary_tail_bits != 0) {
+        allocator->summary_bits[allocator->summary_count - 1] = ((uint64_t) 1 << summary_tail_bits) - 1;
+    }
+
+    allocator->search_hint = 0;
+}
+
+size_t allocator_pool_bitmap_next_live(const Allocator_Pool_Bitmap* allocator, size_t index) {
+    if (index >= allocator->chunk_count) {
+        return allocator->chunk_count;
+    }
+
+    size_t   word_index = index / BITMAP_WORD_BITS;
+    uint64_t live       = ~allocator->free_bits[word_index] & (~(uint64_t) 0 << (index % BITMAP_WORD_BITS));
+
+    for (;;) {
+        if (live != 0) {
+            size_t found = word_index * BITMAP_WORD_BITS + (size_t) __builtin_ctzll(live);
+            return found < allocator->chunk_count ? found : allocator->chunk_count;
+        }
+
+        word_index += 1;
+        if (word_index >= allocator->word_count) {
+            return allocator->chunk_count;
+        }
+        live = ~allocator->free_bits[word_index];
+    }
+}
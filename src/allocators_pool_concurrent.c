@@ -0,0 +1,162 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+/**
+ * The head of the free list packs a 32 bits tag (high half) with the index + 1 of the first free 
+ * chunk (low half, 0 for an empty list). The tag changes on every update, so a compare-and-swap 
+ * with a stale head fails even if the same chunk came back on top in the meantime (ABA problem).
+ */
+static inline uint32_t pool_head_index(uint64_t head) {
+    return (uint32_t) head;
+}
+
+static inline uint64_t pool_head_pack(uint64_t previous_head, uint32_t index) {
+    uint32_t tag = (uint32_t) (previous_head >> 32) + 1;
+    return ((uint64_t) tag << 32) | (uint64_t) index;
+}
+
+static inline Allocator_Pool_Concurrent_Node* pool_concurrent_node(Allocator_Pool_Concurrent* allocator, uint32_t index) {
+    return (Allocator_Pool_Concurrent_Node*) &allocator->buf[(size_t) (index - 1) * allocator->chunk_size];
+}
+
+void allocator_pool_concurrent_init(Allocator_Pool_Concurrent* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) chunk_align);
+    assert(backing_buf_len >= (size_t) (start - initial_start) && "Backing buffer is too small");
+    backing_buf_len -= (size_t) (start - initial_start);
+
+    chunk_size = align_forward_size(chunk_size, chunk_align);
+
+    assert(chunk_size >= sizeof(Allocator_Pool_Concurrent_Node) && "Chunk size is too small");
+    assert(backing_buf_len >= chunk_size && "Backing buffer length is smaller than the chunk size");
+
+    size_t chunk_count = backing_buf_len / chunk_size;
+    if (chunk_count > UINT32_MAX - 1) {
+        // Chunks are referenced by 32 bits indices in the free list
+        chunk_count = UINT32_MAX - 1;
+    }
+
+    allocator->buf         = (uint8_t*) start;
+    allocator->chunk_size  = chunk_size;
+    allocator->chunk_count = chunk_count;
+    atomic_init(&allocator->head, 0);
+    atomic_init(&allocator->unused_index, 0);
+}
+
+void* allocator_pool_concurrent_alloc(Allocator_Pool_Concurrent* allocator) {
+    uint64_t head = atomic_load_explicit(&allocator->head, memory_order_acquire);
+
+    while (pool_head_index(head) != 0) {
+        Allocator_Pool_Concurrent_Node* node = pool_concurrent_node(allocator, pool_head_index(head));
+
+        // The node may be popped and reused concurrently, in which case the CAS below fails because of the tag
+        uint32_t next = atomic_load_explicit(&node->next, memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(&allocator->head, &head, pool_head_pack(head, next), memory_order_acquire, memory_order_acquire)) {
+            return memset(node, 0, allocator->chunk_size);
+        }
+    }
+
+    // The free list is empty, take a chunk never handed out yet
+    size_t unused = atomic_load_explicit(&allocator->unused_index, memory_order_relaxed);
+    while (unused < allocator->chunk_count) {
+        if (atomic_compare_exchange_weak_explicit(&allocator->unused_index, &unused, unused + 1, memory_order_relaxed, memory_order_relaxed)) {
+            return memset(&allocator->buf[unused * allocator->chunk_size], 0, allocator->chunk_size);
+        }
+    }
+
+    return NULL;
+}
+
+void allocator_pool_concurrent_free(Allocator_Pool_Concurrent* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    uintptr_t start = (uintptr_t) allocator->buf;
+    uintptr_t addr  = (uintptr_t) ptr;
+
+    if (addr < start || addr >= start + allocator->chunk_count * allocator->chunk_size) {
+        assert(0 && "Memory is out of bounds of the buffer in this pool");
+        return;
+    }
+
+    uint32_t                        index = (uint32_t) ((addr - start) / allocator->chunk_size) + 1;
+    Allocator_Pool_Concurrent_Node* node  = (Allocator_Pool_Concurrent_Node*) ptr;
+    uint64_t                        head  = atomic_load_explicit(&allocator->head, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&node->next, pool_head_index(head), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&allocator->head, &head, pool_head_pack(head, index), memory_order_release, memory_order_relaxed));
+}
+
+void allocator_pool_concurrent_free_all(Allocator_Pool_Concurrent* allocator) {
+    atomic_store_explicit(&allocator->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&allocator->unused_index, 0, memory_order_relaxed);
+}
+
+
+void allocator_pool_owned_init(Allocator_Pool_Owned* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+    allocator_pool_init_lazy(&allocator->pool, backing_buf, backing_buf_len, chunk_size, chunk_align);
+    allocator->owner = pthread_self();
+    atomic_init(&allocator->remote_free_head, NULL);
+}
+
+size_t allocator_pool_owned_collect(Allocator_Pool_Owned* allocator) {
+    // Only the owner takes from the remote list, and it takes it whole: a plain exchange is ABA-free
+    Allocator_Pool_Free_Node* remote = atomic_exchange_explicit(&allocator->remote_free_head, NULL, memory_order_acquire);
+
+    // Free the chunks through the local pool, which checks each of them as if the owner freed it
+    size_t count = 0;
+    while (remote != NULL) {
+        Allocator_Pool_Free_Node* next = remote->next;
+        allocator_pool_free(&allocator->pool, remote);
+        remote = next;
+        count += 1;
+    }
+
+    return count;
+}
+
+void* allocator_pool_owned_alloc(Allocator_Pool_Owned* allocator) {
+    assert(pthread_equal(pthread_self(), allocator->owner) && "Only the owner thread can allocate from this pool");
+
+    if (allocator->pool.free_list_head == NULL && atomic_load_explicit(&allocator->remote_free_head, memory_order_relaxed) != NULL) {
+        // Slow path: reuse the chunks the other threads freed before taking chunks never handed out,
+        // which would grow the memory in use and spread the allocations
+        allocator_pool_owned_collect(allocator);
+    }
+
+    return allocator_pool_alloc(&allocator->pool);
+}
+
+void allocator_pool_owned_free(Allocator_Pool_Owned* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    if (pthread_equal(pthread_self(), allocator->owner)) {
+        allocator_pool_free(&allocator->pool, ptr);
+        return;
+    }
+
+    uint8_t* addr = (uint8_t*) ptr;
+    if (addr < allocator->pool.buf || addr >= allocator->pool.buf + allocator->pool.buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this pool");
+        return;
+    }
+
+    assert((size_t) (addr - allocator->pool.buf) % allocator->pool.chunk_size == 0 && "Pointer is not the start of a chunk");
+
+    // Foreign thread: push on the remote free list, the owner will collect it
+    Allocator_Pool_Free_Node* node = (Allocator_Pool_Free_Node*) ptr;
+    Allocator_Pool_Free_Node* head = atomic_load_explicit(&allocator->remote_free_head, memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&allocator->remote_free_head, &head, node, memory_order_release, memory_order_relaxed));
+}
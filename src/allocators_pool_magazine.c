@@ -0,0 +1,222 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+static size_t pool_magazine_bytes(size_t magazine_size) {
+    return sizeof(Allocator_Pool_Magazine) + magazine_size * sizeof(void*);
+}
+
+/**
+ * Returns an empty magazine from the depot, or a new one from the backing source. Called with the depot locked.
+ */
+static Allocator_Pool_Magazine* pool_depot_take_empty(Allocator_Pool_Depot* depot) {
+    Allocator_Pool_Magazine* magazine = depot->empty_magazines;
+
+    if (magazine != NULL) {
+        depot->empty_magazines = magazine->next;
+    } else {
+        magazine = (Allocator_Pool_Magazine*) depot->backing.alloc(depot->backing.user_data, pool_magazine_bytes(depot->magazine_size), DEFAULT_ALIGNEMENT);
+        if (magazine == NULL) {
+            return NULL;
+        }
+    }
+
+    magazine->next  = NULL;
+    magazine->count = 0;
+    return magazine;
+}
+
+/**
+ * Gives a magazine to the depot, on the full list if it is full, on the empty list otherwise
+ * (after giving its rounds back to the pool). Called with the depot locked.
+ */
+static void pool_depot_give(Allocator_Pool_Depot* depot, Allocator_Pool_Magazine* magazine) {
+    if (magazine->count == depot->magazine_size) {
+        magazine->next        = depot->full_magazines;
+        depot->full_magazines = magazine;
+        return;
+    }
+
+    allocator_pool_free_n(depot->pool, magazine->rounds, magazine->count);
+
+    magazine->count        = 0;
+    magazine->next         = depot->empty_magazines;
+    depot->empty_magazines = magazine;
+}
+
+void allocator_pool_depot_init(Allocator_Pool_Depot* depot, Allocator_Pool* pool, Allocator_Backing backing, size_t magazine_size) {
+    assert(magazine_size > 0 && "Magazine size must not be zero");
+
+    pthread_mutex_init(&depot->lock, NULL);
+    depot->pool            = pool;
+    depot->full_magazines  = NULL;
+    depot->empty_magazines = NULL;
+    depot->backing         = backing;
+    depot->magazine_size   = magazine_size;
+}
+
+void allocator_pool_depot_destroy(Allocator_Pool_Depot* depot) {
+    Allocator_Pool_Magazine* lists[2] = { depot->full_magazines, depot->empty_magazines };
+
+    for (size_t i = 0; i < 2; i += 1) {
+        Allocator_Pool_Magazine* magazine = lists[i];
+        while (magazine != NULL) {
+            Allocator_Pool_Magazine* next = magazine->next;
+            allocator_pool_free_n(depot->pool, magazine->rounds, magazine->count);
+            depot->backing.free(depot->backing.user_data, magazine, pool_magazine_bytes(depot->magazine_size));
+            magazine = next;
+        }
+    }
+
+    depot->full_magazines  = NULL;
+    depot->empty_magazines = NULL;
+    pthread_mutex_destroy(&depot->lock);
+}
+
+void allocator_pool_magazine_cache_init(Allocator_Pool_Magazine_Cache* cache, Allocator_Pool_Depot* depot) {
+    cache->depot    = depot;
+    cache->loaded   = NULL;
+    cache->previous = NULL;
+}
+
+/**
+ * Slow path of the allocation: both magazines of the cache are empty.
+ */
+static void* pool_magazine_cache_alloc_slow(Allocator_Pool_Magazine_Cache* cache) {
+    Allocator_Pool_Depot* depot = cache->depot;
+
+    pthread_mutex_lock(&depot->lock);
+
+    Allocator_Pool_Magazine* full = depot->full_magazines;
+    if (full != NULL) {
+        // Exchange the empty previous magazine for a full one
+        depot->full_magazines = full->next;
+        if (cache->previous != NULL) {
+            pool_depot_give(depot, cache->previous);
+        }
+        cache->previous = cache->loaded;
+        cache->loaded   = full;
+    } else {
+        // No full magazine in the depot, fill the loaded magazine straight from the pool
+        if (cache->loaded == NULL) {
+            cache->loaded = pool_depot_take_empty(depot);
+        }
+
+        Allocator_Pool_Magazine* loaded = cache->loaded;
+        if (loaded != NULL) {
+            // The rounds are cleared when they are popped, not when they are loaded
+            loaded->count += allocator_pool_alloc_n_no_zero(depot->pool, &loaded->rounds[loaded->count], depot->magazine_size - loaded->count);
+        } else if (allocator_pool_has_free_chunk(depot->pool)) {
+            // Not even an empty magazine available, serve this single request from the pool
+            void* ptr = allocator_pool_alloc(depot->pool);
+            pthread_mutex_unlock(&depot->lock);
+            return ptr;
+        }
+    }
+
+    pthread_mutex_unlock(&depot->lock);
+
+    Allocator_Pool_Magazine* loaded = cache->loaded;
+    if (loaded == NULL || loaded->count == 0) {
+        return NULL;
+    }
+
+    loaded->count -= 1;
+    return memset(loaded->rounds[loaded->count], 0, depot->pool->chunk_size);
+}
+
+void* allocator_pool_magazine_cache_alloc(Allocator_Pool_Magazine_Cache* cache) {
+    Allocator_Pool_Magazine* loaded = cache->loaded;
+
+    if (loaded != NULL && loaded->count > 0) {
+        loaded->count -= 1;
+        return memset(loaded->rounds[loaded->count], 0, cache->depot->pool->chunk_size);
+    }
+
+    Allocator_Pool_Magazine* previous = cache->previous;
+    if (previous != NULL && previous->count > 0) {
+        // The previous magazine is full, swap it with the empty loaded one
+        cache->previous = loaded;
+        cache->loaded   = previous;
+        previous->count -= 1;
+        return memset(previous->rounds[previous->count], 0, cache->depot->pool->chunk_size);
+    }
+
+    return pool_magazine_cache_alloc_slow(cache);
+}
+
+/**
+ * Slow path of the free: both magazines of the cache are full (or missing).
+ */
+static void pool_magazine_cache_free_slow(Allocator_Pool_Magazine_Cache* cache, void* ptr) {
+    Allocator_Pool_Depot* depot = cache->depot;
+
+    pthread_mutex_lock(&depot->lock);
+
+    // Exchange the full previous magazine for an empty one
+    Allocator_Pool_Magazine* empty = pool_depot_take_empty(depot);
+    if (empty == NULL) {
+        allocator_pool_free(depot->pool, ptr);
+        pthread_mutex_unlock(&depot->lock);
+        return;
+    }
+
+    if (cache->previous != NULL) {
+        pool_depot_give(depot, cache->previous);
+    }
+    cache->previous = cache->loaded;
+    cache->loaded   = empty;
+
+    pthread_mutex_unlock(&depot->lock);
+
+    empty->rounds[0] = ptr;
+    empty->count     = 1;
+}
+
+void allocator_pool_magazine_cache_free(Allocator_Pool_Magazine_Cache* cache, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    size_t                   magazine_size = cache->depot->magazine_size;
+    Allocator_Pool_Magazine* loaded        = cache->loaded;
+
+    if (loaded != NULL && loaded->count < magazine_size) {
+        loaded->rounds[loaded->count] = ptr;
+        loaded->count += 1;
+        return;
+    }
+
+    Allocator_Pool_Magazine* previous = cache->previous;
+    if (loaded != NULL && previous != NULL && previous->count == 0) {
+        // The previous magazine is empty, swap it with the full loaded one
+        cache->previous = loaded;
+        cache->loaded   = previous;
+        previous->rounds[0] = ptr;
+        previous->count     = 1;
+        return;
+    }
+
+    pool_magazine_cache_free_slow(cache, ptr);
+}
+
+void allocator_pool_magazine_cache_flush(Allocator_Pool_Magazine_Cache* cache) {
+    Allocator_Pool_Depot* depot = cache->depot;
+
+    pthread_mutex_lock(&depot->lock);
+
+    if (cache->loaded != NULL) {
+        pool_depot_give(depot, cache->loaded);
+    }
+    if (cache->previous != NULL) {
+        pool_depot_give(depot, cache->previous);
+    }
+
+    pthread_mutex_unlock(&depot->lock);
+
+    cache->loaded   = NULL;
+    cache->previous = NULL;
+}
@@ -0,0 +1,182 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+static Allocator_Pool_Handle slot_map_handle(uint32_t slot, uint32_t generation) {
+    return (Allocator_Pool_Handle) ((generation << ALLOCATOR_POOL_HANDLE_INDEX_BITS) | slot);
+}
+
+/**
+ * Returns the slot referenced by the handle, or `NULL` if the handle is stale.
+ */
+static Allocator_Pool_Slot* slot_map_resolve(const Allocator_Pool_Slot_Map* allocator, Allocator_Pool_Handle handle) {
+    uint32_t slot_index = handle & ALLOCATOR_POOL_HANDLE_INDEX_MASK;
+    uint32_t generation = handle >> ALLOCATOR_POOL_HANDLE_INDEX_BITS;
+
+    if (slot_index >= allocator->unused_slot) {
+        return NULL;
+    }
+
+    Allocator_Pool_Slot* slot = &allocator->slots[slot_index];
+    if (slot->generation != generation || slot->index >= allocator->count || allocator->chunk_slots[slot->index] != slot_index) {
+        return NULL;
+    }
+
+    return slot;
+}
+
+/**
+ * Appends a slot to the tail of the free slots, so it is reused after all the slots freed before it.
+ */
+static void slot_map_push_free(Allocator_Pool_Slot_Map* allocator, uint32_t slot_index) {
+    allocator->slots[slot_index].index = allocator->capacity;
+
+    if (allocator->free_slot_head == allocator->capacity) {
+        allocator->free_slot_head = slot_index;
+    } else {
+        allocator->slots[allocator->free_slot_tail].index = slot_index;
+    }
+    allocator->free_slot_tail = slot_index;
+}
+
+/**
+ * Moves a slot to its next generation, wrapping past `ALLOCATOR_POOL_HANDLE_GENERATION_MAX` to 1 so no 
+ * handle is ever equal to ALLOCATOR_POOL_HANDLE_NULL.
+ */
+static void slot_map_next_generation(Allocator_Pool_Slot* slot) {
+    slot->generation = slot->generation < ALLOCATOR_POOL_HANDLE_GENERATION_MAX ? slot->generation + 1 : 1;
+}
+
+void allocator_pool_slot_map_init(Allocator_Pool_Slot_Map* allocator, void* backing_buf, size_t backing_buf_len, size_t chunk_size, size_t chunk_align) {
+    assert(is_power_of_two(chunk_align) && "Chunk alignment must be a power of two");
+
+    // The slots and the back references are stored at the start of the backing buffer, aligned for 32 bits words
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) sizeof(uint32_t));
+    assert(backing_buf_len > (size_t) (start - initial_start) && "Backing buffer is too small");
+    backing_buf_len -= (size_t) (start - initial_start);
+
+    chunk_size = align_forward_size(chunk_size, chunk_align);
+
+    size_t per_chunk = chunk_size + sizeof(Allocator_Pool_Slot) + sizeof(uint32_t);
+    size_t capacity  = backing_buf_len > chunk_align - 1 ? (backing_buf_len - (chunk_align - 1)) / per_chunk : 0;
+    if (capacity > (size_t) ALLOCATOR_POOL_HANDLE_INDEX_MASK + 1) {
+        capacity = (size_t) ALLOCATOR_POOL_HANDLE_INDEX_MASK + 1;
+    }
+
+    assert(capacity > 0 && "Backing buffer length is smaller than the chunk size");
+
+    allocator->slots       = (Allocator_Pool_Slot*) start;
+    allocator->chunk_slots = (uint32_t*) (allocator->slots + capacity);
+    allocator->buf         = (uint8_t*) align_forward_uintptr((uintptr_t) (allocator->chunk_slots + capacity), (uintptr_t) chunk_align);
+    allocator->chunk_size  = chunk_size;
+    allocator->capacity    = (uint32_t) capacity;
+
+    // The generations start at 1 so that no handle is equal to ALLOCATOR_POOL_HANDLE_NULL
+    for (size_t i = 0; i < capacity; i += 1) {
+        allocator->slots[i].generation = 1;
+    }
+
+    allocator->count          = 0;
+    allocator->free_slot_head = allocator->capacity;
+    allocator->free_slot_tail = allocator->capacity;
+    allocator->unused_slot    = 0;
+}
+
+Allocator_Pool_Handle allocator_pool_slot_map_alloc(Allocator_Pool_Slot_Map* allocator) {
+    uint32_t slot_index;
+
+    // Every slot is handed out once before any is reused, then they are reused in the order they were
+    // freed: the generations of all the slots advance together instead of those of a few hot slots
+    if (allocator->unused_slot < allocator->capacity) {
+        slot_index = allocator->unused_slot;
+        allocator->unused_slot += 1;
+    } else if (allocator->free_slot_head != allocator->capacity) {
+        slot_index = allocator->free_slot_head;
+        allocator->free_slot_head = allocator->slots[slot_index].index;
+        if (allocator->free_slot_head == allocator->capacity) {
+            allocator->free_slot_tail = allocator->capacity;
+        }
+    } else {
+        assert(0 && "Slot map allocator has no free memory");
+        return ALLOCATOR_POOL_HANDLE_NULL;
+    }
+
+    // The new object is appended after the live ones
+    uint32_t index = allocator->count;
+    allocator->count += 1;
+
+    Allocator_Pool_Slot* slot = &allocator->slots[slot_index];
+    slot->index = index;
+    allocator->chunk_slots[index] = slot_index;
+
+    memset(&allocator->buf[(size_t) index * allocator->chunk_size], 0, allocator->chunk_size);
+
+    return slot_map_handle(slot_index, slot->generation);
+}
+
+void* allocator_pool_slot_map_get(const Allocator_Pool_Slot_Map* allocator, Allocator_Pool_Handle handle) {
+    Allocator_Pool_Slot* slot = slot_map_resolve(allocator, handle);
+    if (slot == NULL) {
+        return NULL;
+    }
+
+    return &allocator->buf[(size_t) slot->index * allocator->chunk_size];
+}
+
+void allocator_pool_slot_map_free(Allocator_Pool_Slot_Map* allocator, Allocator_Pool_Handle handle) {
+    if (handle == ALLOCATOR_POOL_HANDLE_NULL) {
+        return;
+    }
+
+    Allocator_Pool_Slot* slot = slot_map_resolve(allocator, handle);
+    if (slot == NULL) {
+        assert(0 && "Handle is stale, the object has already been freed");
+        return;
+    }
+
+    // Move the last live object into the hole to keep the objects packed
+    uint32_t index = slot->index;
+    uint32_t last  = allocator->count - 1;
+    if (index != last) {
+        memcpy(&allocator->buf[(size_t) index * allocator->chunk_size], &allocator->buf[(size_t) last * allocator->chunk_size], allocator->chunk_size);
+        uint32_t moved_slot = allocator->chunk_slots[last];
+        allocator->slots[moved_slot].index = index;
+        allocator->chunk_slots[index] = moved_slot;
+    }
+    allocator->count = last;
+
+    slot_map_next_generation(slot);
+    slot_map_push_free(allocator, handle & ALLOCATOR_POOL_HANDLE_INDEX_MASK);
+}
+
+void allocator_pool_slot_map_free_all(Allocator_Pool_Slot_Map* allocator) {
+    allocator->free_slot_head = allocator->capacity;
+    allocator->free_slot_tail = allocator->capacity;
+
+    // Every live slot gets a new generation, and the slots handed out so far are queued by increasing index
+    for (uint32_t i = 0; i < allocator->unused_slot; i += 1) {
+        Allocator_Pool_Slot* slot = &allocator->slots[i];
+
+        bool live = slot->index < allocator->count && allocator->chunk_slots[slot->index] == i;
+        if (live) {
+            slot_map_next_generation(slot);
+        }
+
+        slot_map_push_free(allocator, i);
+    }
+
+    allocator->count = 0;
+}
+
+Allocator_Pool_Handle allocator_pool_slot_map_handle_at(const Allocator_Pool_Slot_Map* allocator, uint32_t index) {
+    if (index >= allocator->count) {
+        assert(0 && "Index is out of the live objects of the slot map");
+        return ALLOCATOR_POOL_HANDLE_NULL;
+    }
+
+    uint32_t slot_index = allocator->chunk_slots[index];
+    return slot_map_handle(slot_index, allocator->slots[slot_index].generation);
+}
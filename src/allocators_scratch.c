@@ -0,0 +1,109 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "allocators.h"
+
+/**
+ * The scratch arenas of a thread, created on the first `allocator_scratch_get` of the thread.
+ */
+typedef struct Scratch_Thread {
+    Allocator_Linear arenas[ALLOCATOR_SCRATCH_COUNT];
+} Scratch_Thread;
+
+static pthread_once_t scratch_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t  scratch_key;
+
+// Cached copy of the thread-specific value, so the fast path does not go through `pthread_getspecific`.
+static _Thread_local Scratch_Thread* scratch_thread = NULL;
+
+static void scratch_thread_destroy(void* ptr) {
+    Scratch_Thread* thread = (Scratch_Thread*) ptr;
+
+    for (size_t i = 0; i < ALLOCATOR_SCRATCH_COUNT; i += 1) {
+        if (thread->arenas[i].buf != NULL) {
+            ALLOCATOR_BACKING_MMAP.free(NULL, thread->arenas[i].buf, thread->arenas[i].buf_len);
+        }
+    }
+
+    free(thread);
+
+    // The destructor runs on the exiting thread, whose cache must not keep pointing at the freed arenas
+    scratch_thread = NULL;
+}
+
+static void scratch_key_create(void) {
+    int result = pthread_key_create(&scratch_key, scratch_thread_destroy);
+    assert(result == 0 && "Failed to create the scratch arenas thread key");
+    (void) result;
+}
+
+static Scratch_Thread* scratch_thread_get(void) {
+    if (scratch_thread != NULL) {
+        return scratch_thread;
+    }
+
+    pthread_once(&scratch_key_once, scratch_key_create);
+
+    Scratch_Thread* thread = (Scratch_Thread*) calloc(1, sizeof(Scratch_Thread));
+    if (thread == NULL) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < ALLOCATOR_SCRATCH_COUNT; i += 1) {
+        // Mapped pages are only backed by physical memory once touched, a large arena costs nothing up front.
+        void* buf = ALLOCATOR_BACKING_MMAP.alloc(NULL, ALLOCATOR_SCRATCH_SIZE, DEFAULT_ALIGNEMENT);
+        if (buf == NULL) {
+            scratch_thread_destroy(thread);
+            return NULL;
+        }
+
+        allocator_linear_init(&thread->arenas[i], buf, ALLOCATOR_SCRATCH_SIZE);
+        thread->arenas[i].zero_policy  = ALLOCATOR_ZERO_LAZY;
+        thread->arenas[i].dirty_offset = 0;
+    }
+
+    pthread_setspecific(scratch_key, thread);
+    scratch_thread = thread;
+    return thread;
+}
+
+Allocator_Linear_Temp allocator_scratch_get(Allocator_Linear* const* conflicts, size_t conflict_count) {
+    Allocator_Linear_Temp temp = { NULL, 0, 0 };
+
+    Scratch_Thread* thread = scratch_thread_get();
+    if (thread == NULL) {
+        return temp;
+    }
+
+    for (size_t i = 0; i < ALLOCATOR_SCRATCH_COUNT; i += 1) {
+        Allocator_Linear* arena = &thread->arenas[i];
+
+        bool conflicting = false;
+        for (size_t j = 0; j < conflict_count; j += 1) {
+            if (conflicts[j] == arena) {
+                conflicting = true;
+                break;
+            }
+        }
+
+        if (!conflicting) {
+            return allocator_linear_temp_begin(arena);
+        }
+    }
+
+    assert(0 && "Every scratch arena of the thread conflicts, raise ALLOCATOR_SCRATCH_COUNT");
+    return temp;
+}
+
+void allocator_scratch_release(void) {
+    Scratch_Thread* thread = scratch_thread;
+    if (thread == NULL) {
+        return;
+    }
+
+    // The key no longer holds the arenas, the destructor will not free them a second time at thread exit
+    pthread_setspecific(scratch_key, NULL);
+    scratch_thread_destroy(thread);
+}
@@ -0,0 +1,225 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+#define SLAB_FINE_SHIFT   3    // Granule of the lookup table up to `SLAB_FINE_LIMIT`, 8 bytes
+#define SLAB_COARSE_SHIFT 7    // Granule of the lookup table past `SLAB_FINE_LIMIT`, 128 bytes
+#define SLAB_FINE_LIMIT   1024
+
+_Static_assert(ALLOCATOR_SLAB_MAX_CLASSES <= 256, "Class indices are stored on a byte in the lookup table");
+_Static_assert(ALLOCATOR_SLAB_MAX_CLASS_SIZE % (1 << SLAB_COARSE_SHIFT) == 0, "Largest class size must be a multiple of 128 bytes");
+
+static const size_t SLAB_DEFAULT_CLASSES[] = {
+    8, 16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256, 320, 384, 448, 512,
+    640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+    2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192,
+    10240, 12288, 14336, 16384, 20480, 24576, 28672, 32768,
+};
+
+/**
+ * Entry of the lookup table for a request of `size` bytes: 8 bytes granules for the small sizes,
+ * where the classes are close to each other, then 128 bytes granules.
+ */
+static inline size_t slab_lookup_index(size_t size) {
+    if (size <= SLAB_FINE_LIMIT) {
+        return (size + (1 << SLAB_FINE_SHIFT) - 1) >> SLAB_FINE_SHIFT;
+    }
+    return (SLAB_FINE_LIMIT >> SLAB_FINE_SHIFT) + ((size - SLAB_FINE_LIMIT + (1 << SLAB_COARSE_SHIFT) - 1) >> SLAB_COARSE_SHIFT);
+}
+
+/**
+ * Largest request size mapped to the entry `index` of the lookup table.
+ */
+static inline size_t slab_lookup_size(size_t index) {
+    if (index <= (SLAB_FINE_LIMIT >> SLAB_FINE_SHIFT)) {
+        return index << SLAB_FINE_SHIFT;
+    }
+    return SLAB_FINE_LIMIT + ((index - (SLAB_FINE_LIMIT >> SLAB_FINE_SHIFT)) << SLAB_COARSE_SHIFT);
+}
+
+/**
+ * Offset of the memory of a large object from its header, which keeps it aligned to the default alignment.
+ */
+static inline size_t slab_large_header_size(void) {
+    return align_forward_size(sizeof(Allocator_Pool_Slab), DEFAULT_ALIGNEMENT);
+}
+
+static void slab_large_push(Allocator_Slab* allocator, Allocator_Pool_Slab* large) {
+    large->prev = NULL;
+    large->next = allocator->large_objects;
+    if (large->next != NULL) {
+        large->next->prev = large;
+    }
+    allocator->large_objects = large;
+}
+
+static void slab_large_unlink(Allocator_Slab* allocator, Allocator_Pool_Slab* large) {
+    if (large->prev != NULL) {
+        large->prev->next = large->next;
+    } else {
+        allocator->large_objects = large->next;
+    }
+    if (large->next != NULL) {
+        large->next->prev = large->prev;
+    }
+}
+
+static void* slab_large_alloc(Allocator_Slab* allocator, size_t size) {
+    size_t header_size = slab_large_header_size();
+    if (size > SIZE_MAX - header_size - allocator->slab_size) {
+        return NULL;
+    }
+
+    // Aligned like the slabs, so `allocator_pool_slab_of` finds the header of a large object as well
+    Allocator_Pool_Slab* large = (Allocator_Pool_Slab*) allocator->backing.alloc(allocator->backing.user_data, header_size + size, allocator->slab_size);
+    if (large == NULL) {
+        return NULL;
+    }
+
+    // A large object is a slab of a single chunk, without owner
+    large->pool.buf      = (uint8_t*) large + header_size;
+    large->pool.buf_len  = size;
+    large->owner         = NULL;
+    large->used_count    = 1;
+    large->chunk_count   = 1;
+    slab_large_push(allocator, large);
+
+    if (!allocator->backing.zero_filled) {
+        memset(large->pool.buf, 0, size);
+    }
+
+    return large->pool.buf;
+}
+
+static void slab_large_free(Allocator_Slab* allocator, Allocator_Pool_Slab* large) {
+    slab_large_unlink(allocator, large);
+    allocator->backing.free(allocator->backing.user_data, large, slab_large_header_size() + large->pool.buf_len);
+}
+
+void allocator_slab_init(Allocator_Slab* allocator, Allocator_Backing backing, const size_t* class_sizes, size_t class_count, size_t retained_empty_slabs) {
+    if (class_sizes == NULL) {
+        class_sizes = SLAB_DEFAULT_CLASSES;
+        class_count = sizeof(SLAB_DEFAULT_CLASSES) / sizeof(SLAB_DEFAULT_CLASSES[0]);
+    }
+
+    assert(class_count > 0 && class_count <= ALLOCATOR_SLAB_MAX_CLASSES && "Class count must be between 1 and ALLOCATOR_SLAB_MAX_CLASSES");
+    assert(class_sizes[class_count - 1] <= ALLOCATOR_SLAB_MAX_CLASS_SIZE && "Class size is larger than ALLOCATOR_SLAB_MAX_CLASS_SIZE");
+
+    allocator->class_count    = class_count;
+    allocator->max_class_size = class_sizes[class_count - 1];
+    allocator->large_objects  = NULL;
+    allocator->backing        = backing;
+    allocator->slab_size      = ALLOCATOR_SLAB_SLAB_SIZE;
+
+    for (size_t i = 0; i < class_count; i += 1) {
+        size_t size = class_sizes[i];
+        assert(size >= sizeof(void*) && size % sizeof(void*) == 0 && "Class size must be a multiple of the pointer size");
+        assert((i == 0 || size > class_sizes[i - 1]) && "Class sizes must be in increasing order");
+
+        // Chunks are aligned to the largest power of two dividing their size, up to the default
+        // alignment, so no byte is lost to padding between them
+        size_t align = size & (~size + 1);
+        if (align > DEFAULT_ALIGNEMENT) {
+            align = DEFAULT_ALIGNEMENT;
+        }
+
+        allocator_pool_growable_init(&allocator->classes[i], backing, allocator->slab_size, size, align, retained_empty_slabs);
+    }
+
+    // Each entry maps to the smallest class holding every size of its granule
+    size_t class_index = 0;
+    for (size_t i = 0; i < ALLOCATOR_SLAB_LOOKUP_COUNT; i += 1) {
+        size_t size = slab_lookup_size(i);
+        while (class_index < class_count && class_sizes[class_index] < size) {
+            class_index += 1;
+        }
+        allocator->lookup[i] = (uint8_t) (class_index < class_count ? class_index : class_count - 1);
+    }
+}
+
+void* allocator_slab_alloc(Allocator_Slab* allocator, size_t size) {
+    if (size > allocator->max_class_size) {
+        return slab_large_alloc(allocator, size);
+    }
+
+    return allocator_pool_growable_alloc(&allocator->classes[allocator->lookup[slab_lookup_index(size)]]);
+}
+
+void allocator_slab_free(Allocator_Slab* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    // Slabs and large objects are aligned to the slab size, the header is found from any pointer into them
+    Allocator_Pool_Slab* slab = allocator_pool_slab_of(ptr, allocator->slab_size);
+
+    if (slab->owner == NULL) {
+        assert(ptr == slab->pool.buf && "Pointer is not the start of a large object");
+        slab_large_free(allocator, slab);
+        return;
+    }
+
+    if (slab->owner < allocator->classes || slab->owner >= allocator->classes + allocator->class_count) {
+        assert(0 && "Memory does not belong to this slab allocator");
+        return;
+    }
+
+    allocator_pool_growable_free(slab->owner, ptr);
+}
+
+size_t allocator_slab_usable_size(Allocator_Slab* allocator, void* ptr) {
+    Allocator_Pool_Slab* slab = allocator_pool_slab_of(ptr, allocator->slab_size);
+    return slab->owner == NULL ? slab->pool.buf_len : slab->owner->chunk_size;
+}
+
+void* allocator_slab_resize(Allocator_Slab* allocator, void* old_memory, size_t old_size, size_t new_size) {
+    if (old_memory == NULL) {
+        return allocator_slab_alloc(allocator, new_size);
+    }
+
+    if (new_size == 0) {
+        allocator_slab_free(allocator, old_memory);
+        return NULL;
+    }
+
+    // Stay in place while the new size fits in the chunk, or in the large object
+    if (new_size <= allocator_slab_usable_size(allocator, old_memory)) {
+        if (new_size > old_size) {
+            memset((uint8_t*) old_memory + old_size, 0, new_size - old_size);
+        }
+        return old_memory;
+    }
+
+    void* new_memory = allocator_slab_alloc(allocator, new_size);
+    if (new_memory == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_memory, old_memory, old_size < new_size ? old_size : new_size);
+    allocator_slab_free(allocator, old_memory);
+
+    return new_memory;
+}
+
+void allocator_slab_free_all(Allocator_Slab* allocator) {
+    while (allocator->large_objects != NULL) {
+        slab_large_free(allocator, allocator->large_objects);
+    }
+
+    for (size_t i = 0; i < allocator->class_count; i += 1) {
+        allocator_pool_growable_free_all(&allocator->classes[i]);
+    }
+}
+
+void allocator_slab_destroy(Allocator_Slab* allocator) {
+    while (allocator->large_objects != NULL) {
+        slab_large_free(allocator, allocator->large_objects);
+    }
+
+    for (size_t i = 0; i < allocator->class_count; i += 1) {
+        allocator_pool_growable_destroy(&allocator->classes[i]);
+    }
+}
@@ -75,9 +75,42 @@ void allocator_stack_init(Allocator_Stack* allocator, void* backing_buf, size_t
     allocator->buf_len = backing_buf_len;
     allocator->prev_offset = 0;
     allocator->curr_offset = 0;
+
+    // Nothing is known about the content of the buffer, all of it is considered dirty.
+    allocator->zero_policy  = ALLOCATOR_ZERO_ALWAYS;
+    allocator->dirty_offset = backing_buf_len;
 }
 
-void* allocator_stack_alloc_align(Allocator_Stack* allocator, size_t data_size, size_t align) {
+void allocator_stack_set_zero_policy(Allocator_Stack* allocator, Allocator_Zero_Policy zero_policy) {
+    allocator->zero_policy = zero_policy;
+}
+
+/**
+ * Clears the `size` bytes at `offset` according to the zeroing policy of the allocator.
+ * With `ALLOCATOR_ZERO_LAZY`, only the bytes under the dirty high-water mark are cleared.
+ */
+static void stack_zero(Allocator_Stack* allocator, size_t offset, size_t size) {
+    size_t end = offset + size;
+
+    switch (allocator->zero_policy) {
+        case ALLOCATOR_ZERO_ALWAYS:
+            memset(&allocator->buf[offset], 0, size);
+            break;
+        case ALLOCATOR_ZERO_NEVER:
+            break;
+        case ALLOCATOR_ZERO_LAZY:
+            if (offset < allocator->dirty_offset) {
+                memset(&allocator->buf[offset], 0, (end < allocator->dirty_offset ? end : allocator->dirty_offset) - offset);
+            }
+            break;
+    }
+
+    if (end > allocator->dirty_offset) {
+        allocator->dirty_offset = end;
+    }
+}
+
+static void* stack_alloc_align(Allocator_Stack* allocator, size_t data_size, size_t align, bool zero) {
     assert(is_power_of_two(align));
     
     uintptr_t curr_addr, next_addr;
@@ -110,14 +143,33 @@ void* allocator_stack_alloc_align(Allocator_Stack* allocator, size_t data_size,
     header->prev_offset = allocator->prev_offset;
 
     allocator->curr_offset += data_size;
-    
-    return memset((void*) next_addr, 0, data_size);
+
+    if (zero) {
+        stack_zero(allocator, allocator->curr_offset - data_size, data_size);
+    } else if (allocator->curr_offset > allocator->dirty_offset) {
+        // The caller is about to write there, the bytes can no longer be assumed to be zero.
+        allocator->dirty_offset = allocator->curr_offset;
+    }
+
+    return (void*) next_addr;
+}
+
+void* allocator_stack_alloc_align(Allocator_Stack* allocator, size_t data_size, size_t align) {
+    return stack_alloc_align(allocator, data_size, align, true);
 }
 
 void* allocator_stack_alloc(Allocator_Stack* allocator, size_t data_size) {
     return allocator_stack_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
 }
 
+void* allocator_stack_alloc_align_no_zero(Allocator_Stack* allocator, size_t data_size, size_t align) {
+    return stack_alloc_align(allocator, data_size, align, false);
+}
+
+void* allocator_stack_alloc_no_zero(Allocator_Stack* allocator, size_t data_size) {
+    return allocator_stack_alloc_align_no_zero(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
 void allocator_stack_free(Allocator_Stack* allocator, void* ptr) {
     if (ptr != NULL) {
         uintptr_t start     = (uintptr_t) allocator->buf;
@@ -168,7 +220,7 @@ void* allocator_stack_resize_align(Allocator_Stack* allocator, void* ptr, size_t
         allocator->curr_offset = allocator->prev_offset + new_data_size;
         if (new_data_size > old_data_size) {
             // Is the memory block grow, the new bytes are set to 0 by default.
-            memset(&allocator->buf[allocator->curr_offset], 0, new_data_size - old_data_size);
+            stack_zero(allocator, allocator->curr_offset - (new_data_size - old_data_size), new_data_size - old_data_size);
         }
 
         return ptr;
@@ -0,0 +1,341 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "allocators.h"
+
+#define TLSF_USED      ((size_t) 1) // The block is allocated
+#define TLSF_PREV_USED ((size_t) 2) // The previous block is allocated, `prev_size` is not valid
+#define TLSF_FLAGS     (TLSF_USED | TLSF_PREV_USED)
+
+#define TLSF_HEADER_SIZE     sizeof(Allocator_Free_List_Header)
+#define TLSF_MIN_BLOCK_SIZE  (TLSF_HEADER_SIZE + sizeof(Allocator_Free_List_Node))
+
+// Blocks smaller than this are all in the first level 0, split linearly in `ALLOCATOR_TLSF_SL_COUNT` lists
+#define TLSF_SMALL_BLOCK_SIZE ((size_t) ALLOCATOR_TLSF_SL_COUNT * DEFAULT_ALIGNEMENT)
+#define TLSF_MAX_BLOCK_SIZE   (TLSF_SMALL_BLOCK_SIZE << (ALLOCATOR_TLSF_FL_COUNT - 1))
+
+_Static_assert(sizeof(Allocator_Free_List_Header) == DEFAULT_ALIGNEMENT, "TLSF header must be as large as the default alignment");
+_Static_assert(ALLOCATOR_TLSF_FL_COUNT <= 32 && ALLOCATOR_TLSF_SL_COUNT <= 32, "TLSF bitmaps are 32 bits words");
+
+static inline size_t tlsf_block_size(const Allocator_Free_List_Header* block) {
+    return block->size & ~TLSF_FLAGS;
+}
+
+static inline Allocator_Free_List_Header* tlsf_block_at(void* ptr, size_t offset) {
+    return (Allocator_Free_List_Header*) ((uint8_t*) ptr + offset);
+}
+
+static inline Allocator_Free_List_Node* tlsf_node_of(Allocator_Free_List_Header* block) {
+    return (Allocator_Free_List_Node*) (block + 1);
+}
+
+static inline Allocator_Free_List_Header* tlsf_block_of(Allocator_Free_List_Node* node) {
+    return ((Allocator_Free_List_Header*) node) - 1;
+}
+
+static inline size_t tlsf_log2(size_t value) {
+    return sizeof(unsigned long long) * 8 - 1 - (size_t) __builtin_clzll((unsigned long long) value);
+}
+
+static size_t tlsf_needed_size(size_t data_size) {
+    size_t size = align_forward_size(data_size + TLSF_HEADER_SIZE, DEFAULT_ALIGNEMENT);
+    return size < TLSF_MIN_BLOCK_SIZE ? TLSF_MIN_BLOCK_SIZE : size;
+}
+
+/**
+ * First and second level indices of the list holding free blocks of `size` bytes.
+ */
+static void tlsf_mapping(size_t size, size_t* fl, size_t* sl) {
+    if (size < TLSF_SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = size / DEFAULT_ALIGNEMENT;
+        return;
+    }
+
+    // The first level is the power of two of the size, the second level the next bits below it
+    size_t log2 = tlsf_log2(size);
+    *sl = (size >> (log2 - ALLOCATOR_TLSF_SL_LOG2)) ^ ((size_t) 1 << ALLOCATOR_TLSF_SL_LOG2);
+    *fl = log2 - tlsf_log2(TLSF_SMALL_BLOCK_SIZE) + 1;
+}
+
+static void tlsf_insert(Allocator_Tlsf* allocator, Allocator_Free_List_Header* block) {
+    size_t fl, sl;
+    tlsf_mapping(tlsf_block_size(block), &fl, &sl);
+
+    Allocator_Free_List_Node* node = tlsf_node_of(block);
+    node->prev = NULL;
+    node->next = allocator->free_lists[fl][sl];
+    if (node->next != NULL) {
+        node->next->prev = node;
+    }
+    allocator->free_lists[fl][sl] = node;
+
+    allocator->fl_bitmap     |= (uint32_t) 1 << fl;
+    allocator->sl_bitmap[fl] |= (uint32_t) 1 << sl;
+}
+
+static void tlsf_remove(Allocator_Tlsf* allocator, Allocator_Free_List_Header* block) {
+    size_t fl, sl;
+    tlsf_mapping(tlsf_block_size(block), &fl, &sl);
+
+    Allocator_Free_List_Node* node = tlsf_node_of(block);
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        allocator->free_lists[fl][sl] = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+
+    if (allocator->free_lists[fl][sl] == NULL) {
+        allocator->sl_bitmap[fl] &= ~((uint32_t) 1 << sl);
+        if (allocator->sl_bitmap[fl] == 0) {
+            allocator->fl_bitmap &= ~((uint32_t) 1 << fl);
+        }
+    }
+}
+
+/**
+ * Returns a free block of at least `size` bytes, in O(1): the size is rounded up to the next list
+ * boundary so every block of the list found fits, then the first non-empty list at or above it is
+ * found with two bit scans.
+ */
+static Allocator_Free_List_Header* tlsf_find(Allocator_Tlsf* allocator, size_t size) {
+    if (size >= TLSF_SMALL_BLOCK_SIZE) {
+        size += ((size_t) 1 << (tlsf_log2(size) - ALLOCATOR_TLSF_SL_LOG2)) - 1;
+    }
+    if (size >= TLSF_MAX_BLOCK_SIZE) {
+        return NULL;
+    }
+
+    size_t fl, sl;
+    tlsf_mapping(size, &fl, &sl);
+
+    uint32_t sl_map = allocator->sl_bitmap[fl] & (~(uint32_t) 0 << sl);
+    if (sl_map == 0) {
+        uint32_t fl_map = fl + 1 < 32 ? allocator->fl_bitmap & (~(uint32_t) 0 << (fl + 1)) : 0;
+        if (fl_map == 0) {
+            return NULL;
+        }
+        fl     = (size_t) __builtin_ctz(fl_map);
+        sl_map = allocator->sl_bitmap[fl];
+    }
+    sl = (size_t) __builtin_ctz(sl_map);
+
+    return tlsf_block_of(allocator->free_lists[fl][sl]);
+}
+
+static void tlsf_set_free(Allocator_Free_List_Header* block, size_t size) {
+    block->size = size | (block->size & TLSF_PREV_USED);
+
+    Allocator_Free_List_Header* next = tlsf_block_at(block, size);
+    next->prev_size = size;
+    next->size     &= ~TLSF_PREV_USED;
+}
+
+static void tlsf_set_used(Allocator_Free_List_Header* block, size_t size) {
+    block->size = size | TLSF_USED | (block->size & TLSF_PREV_USED);
+    tlsf_block_at(block, size)->size |= TLSF_PREV_USED;
+}
+
+static void tlsf_trim(Allocator_Tlsf* allocator, Allocator_Free_List_Header* block, size_t size) {
+    size_t block_size = tlsf_block_size(block);
+    if (block_size - size < TLSF_MIN_BLOCK_SIZE) {
+        return;
+    }
+
+    Allocator_Free_List_Header* tail = tlsf_block_at(block, size);
+    tail->size = (block_size - size) | TLSF_USED | TLSF_PREV_USED;
+    block->size = size | (block->size & TLSF_FLAGS);
+
+    allocator_tlsf_free(allocator, tail + 1);
+}
+
+void allocator_tlsf_init(Allocator_Tlsf* allocator, void* backing_buf, size_t backing_buf_len) {
+    // Align the backing buffer so the blocks, and the memory following their headers, are aligned
+    uintptr_t initial_start = (uintptr_t) backing_buf;
+    uintptr_t start         = align_forward_uintptr(initial_start, (uintptr_t) DEFAULT_ALIGNEMENT);
+    size_t    padding       = (size_t) (start - initial_start);
+
+    assert(backing_buf_len >= padding + TLSF_MIN_BLOCK_SIZE + TLSF_HEADER_SIZE && "Backing buffer is too small");
+
+    size_t buf_len = (backing_buf_len - padding) & ~(DEFAULT_ALIGNEMENT - 1);
+    if (buf_len - TLSF_HEADER_SIZE >= TLSF_MAX_BLOCK_SIZE) {
+        // The free block covering the buffer must be indexed by the lists
+        buf_len = TLSF_MAX_BLOCK_SIZE - DEFAULT_ALIGNEMENT;
+    }
+
+    allocator->buf     = (uint8_t*) start;
+    allocator->buf_len = buf_len;
+
+    allocator_tlsf_free_all(allocator);
+}
+
+void* allocator_tlsf_alloc_align(Allocator_Tlsf* allocator, size_t data_size, size_t data_align) {
+    assert(is_power_of_two(data_align) && "Alignment must be a power of two");
+
+    size_t needed = tlsf_needed_size(data_size);
+
+    // A larger alignment may need a gap in front of the allocation, search for a block fitting the largest one
+    size_t search = needed;
+    if (data_align > DEFAULT_ALIGNEMENT) {
+        search += data_align + TLSF_MIN_BLOCK_SIZE;
+    }
+
+    Allocator_Free_List_Header* block = tlsf_find(allocator, search);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    tlsf_remove(allocator, block);
+    size_t block_size = tlsf_block_size(block);
+    assert(block_size >= search && "Free block is smaller than its class");
+
+    if (data_align > DEFAULT_ALIGNEMENT) {
+        uintptr_t data = (uintptr_t) (block + 1);
+        size_t    gap  = (size_t) (align_forward_uintptr(data, (uintptr_t) data_align) - data);
+        if (gap != 0 && gap < TLSF_MIN_BLOCK_SIZE) {
+            gap = (size_t) (align_forward_uintptr(data + TLSF_MIN_BLOCK_SIZE, (uintptr_t) data_align) - data);
+        }
+
+        if (gap != 0) {
+            // The gap goes back to the lists as a smaller free block, the allocation starts after it
+            tlsf_set_free(block, gap);
+            tlsf_insert(allocator, block);
+            block       = tlsf_block_at(block, gap);
+            block->size = block_size - gap;
+            block_size -= gap;
+        }
+    }
+
+    if (block_size - needed >= TLSF_MIN_BLOCK_SIZE) {
+        // Split off the end of the block, it goes back to the lists
+        Allocator_Free_List_Header* tail = tlsf_block_at(block, needed);
+        tail->size = TLSF_PREV_USED;
+        tlsf_set_free(tail, block_size - needed);
+        tlsf_insert(allocator, tail);
+
+        block->size = needed | TLSF_USED | (block->size & TLSF_PREV_USED);
+    } else {
+        tlsf_set_used(block, block_size);
+    }
+
+    return memset(block + 1, 0, data_size);
+}
+
+void* allocator_tlsf_alloc(Allocator_Tlsf* allocator, size_t data_size) {
+    return allocator_tlsf_alloc_align(allocator, data_size, DEFAULT_ALIGNEMENT);
+}
+
+void allocator_tlsf_free(Allocator_Tlsf* allocator, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    if ((uint8_t*) ptr < allocator->buf + TLSF_HEADER_SIZE || (uint8_t*) ptr >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this TLSF allocator");
+        return;
+    }
+
+    Allocator_Free_List_Header* block = ((Allocator_Free_List_Header*) ptr) - 1;
+    if (!(block->size & TLSF_USED)) {
+        assert(0 && "Memory is already free");
+        return;
+    }
+
+    size_t size = tlsf_block_size(block);
+
+    // Merge with the following block
+    Allocator_Free_List_Header* next = tlsf_block_at(block, size);
+    if (!(next->size & TLSF_USED)) {
+        tlsf_remove(allocator, next);
+        size += tlsf_block_size(next);
+    }
+
+    // Merge into the previous block, found through its boundary tag. Its size changes, so it moves to another list.
+    if (!(block->size & TLSF_PREV_USED)) {
+        Allocator_Free_List_Header* prev = (Allocator_Free_List_Header*) ((uint8_t*) block - block->prev_size);
+        tlsf_remove(allocator, prev);
+        size += tlsf_block_size(prev);
+        block = prev;
+    }
+
+    tlsf_set_free(block, size);
+    tlsf_insert(allocator, block);
+}
+
+void allocator_tlsf_free_all(Allocator_Tlsf* allocator) {
+    memset(allocator->free_lists, 0, sizeof(allocator->free_lists));
+    memset(allocator->sl_bitmap, 0, sizeof(allocator->sl_bitmap));
+    allocator->fl_bitmap = 0;
+
+    size_t size = allocator->buf_len - TLSF_HEADER_SIZE;
+
+    // The last header is an empty used block, so no merge ever goes past the end of the buffer
+    Allocator_Free_List_Header* end = tlsf_block_at(allocator->buf, size);
+    end->size = TLSF_USED;
+
+    Allocator_Free_List_Header* first = (Allocator_Free_List_Header*) allocator->buf;
+    first->prev_size = 0;
+    first->size      = TLSF_PREV_USED;
+    tlsf_set_free(first, size);
+    tlsf_insert(allocator, first);
+}
+
+void* allocator_tlsf_resize_align(Allocator_Tlsf* allocator, void* old_memory, size_t old_size, size_t new_size, size_t align) {
+    assert(is_power_of_two(align) && "Alignment must be a power of two");
+
+    if (old_memory == NULL) {
+        return allocator_tlsf_alloc_align(allocator, new_size, align);
+    }
+
+    if ((uint8_t*) old_memory < allocator->buf + TLSF_HEADER_SIZE || (uint8_t*) old_memory >= allocator->buf + allocator->buf_len) {
+        assert(0 && "Memory is out of bounds of the buffer in this TLSF allocator");
+        return NULL;
+    }
+
+    if (new_size == 0) {
+        allocator_tlsf_free(allocator, old_memory);
+        return NULL;
+    }
+
+    Allocator_Free_List_Header* block      = ((Allocator_Free_List_Header*) old_memory) - 1;
+    size_t                      block_size = tlsf_block_size(block);
+    size_t                      needed     = tlsf_needed_size(new_size);
+
+    if (((uintptr_t) old_memory & (align - 1)) == 0) {
+        if (needed > block_size) {
+            // Grow in place by taking the following block, when it is free and large enough
+            Allocator_Free_List_Header* next = tlsf_block_at(block, block_size);
+            if (!(next->size & TLSF_USED) && block_size + tlsf_block_size(next) >= needed) {
+                tlsf_remove(allocator, next);
+                block_size += tlsf_block_size(next);
+                tlsf_set_used(block, block_size);
+            }
+        }
+
+        if (needed <= block_size) {
+            tlsf_trim(allocator, block, needed);
+            if (new_size > old_size) {
+                memset((uint8_t*) old_memory + old_size, 0, new_size - old_size);
+            }
+            return old_memory;
+        }
+    }
+
+    void* new_memory = allocator_tlsf_alloc_align(allocator, new_size, align);
+    if (new_memory == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_memory, old_memory, old_size < new_size ? old_size : new_size);
+    allocator_tlsf_free(allocator, old_memory);
+
+    return new_memory;
+}
+
+void* allocator_tlsf_resize(Allocator_Tlsf* allocator, void* old_memory, size_t old_size, size_t new_size) {
+    return allocator_tlsf_resize_align(allocator, old_memory, old_size, new_size, DEFAULT_ALIGNEMENT);
+}
@@ -1,3 +1,4 @@
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -38,6 +39,34 @@ void demo_allocator_linear() {
     printf("\n\n");
 }
 
+void demo_allocator_linear_growable() {
+    printf("# Growable Linear Allocator\n\n");
+    Allocator_Linear_Growable allocator;
+    allocator_linear_growable_init(&allocator, ALLOCATOR_BACKING_MALLOC, 64, 1);
+
+    // Each block only holds a few positions, the allocator chains new ones as needed.
+    Position* pos_1 = NULL;
+    for (uint32_t i = 0; i < 8; i += 1) {
+        Position* pos = (Position*) allocator_linear_growable_alloc(&allocator, sizeof(Position));
+        pos->x = i;
+        pos->y = i * 2;
+        printf("Position %d (%08" PRIxPTR "): x=%d y=%d\n", i + 1, (uintptr_t)pos, pos->x, pos->y);
+        if (pos_1 == NULL) {
+            pos_1 = pos;
+        }
+    }
+
+    allocator_linear_growable_free(&allocator);
+    printf("Allocator freed\n");
+
+    // Should have same address as pos_1, because the allocator rewinds to its first block.
+    Position* pos_9 = (Position*) allocator_linear_growable_alloc(&allocator, sizeof(Position));
+    printf("Position 9 (%08" PRIxPTR "): same as Position 1: %s\n", (uintptr_t)pos_9, pos_9 == pos_1 ? "yes" : "no");
+
+    allocator_linear_growable_destroy(&allocator);
+    printf("\n\n");
+}
+
 void demo_allocator_stack() {
     printf("# Stack Allocator\n\n");
     uint8_t back_buf[BACK_BUF_LEN];
@@ -70,7 +99,7 @@ void demo_allocator_stack() {
 
 void demo_allocator_pool() {
     printf("# Pool Allocator\n\n");
-    uint8_t back_buf[sizeof(Position) * 10];
+    uint8_t back_buf[BACK_BUF_LEN];
 
     Allocator_Pool allocator;
     allocator_pool_init(&allocator, back_buf, BACK_BUF_LEN, sizeof(Position), 32);
@@ -98,10 +127,42 @@ void demo_allocator_pool() {
     printf("\n\n");
 }
 
+void demo_allocator_free_list() {
+    printf("# Free List Allocator\n\n");
+    uint8_t back_buf[BACK_BUF_LEN];
+
+    Allocator_Free_List allocator;
+    allocator_free_list_init(&allocator, back_buf, BACK_BUF_LEN);
+
+    Position* pos_1 = (Position*) allocator_free_list_alloc(&allocator, sizeof(Position));
+    pos_1->x = 10;
+    pos_1->y = 20;
+    printf("Position 1 (%08" PRIxPTR "): x=%d y=%d\n", (uintptr_t)pos_1, pos_1->x, pos_1->y);
+
+    Position* positions = (Position*) allocator_free_list_alloc(&allocator, 4 * sizeof(Position));
+    printf("Positions (%08" PRIxPTR "): 4 positions\n", (uintptr_t)positions);
+
+    allocator_free_list_free(&allocator, pos_1);
+    printf("Position 1 (%08" PRIxPTR ") freed\n", (uintptr_t)pos_1);
+
+    // Should have same address as pos_1, because pos_1 has been freed.
+    Position* pos_2 = (Position*) allocator_free_list_alloc(&allocator, sizeof(Position));
+    printf("Position 2 (%08" PRIxPTR "): same as Position 1: %s\n", (uintptr_t)pos_2, pos_2 == pos_1 ? "yes" : "no");
+
+    // Grows in place, the block following the positions is free.
+    Position* more_positions = (Position*) allocator_free_list_resize(&allocator, positions, 4 * sizeof(Position), 8 * sizeof(Position));
+    printf("Positions (%08" PRIxPTR "): 8 positions, resized in place: %s\n", (uintptr_t)more_positions, more_positions == positions ? "yes" : "no");
+
+    allocator_free_list_free_all(&allocator);
+    printf("\n\n");
+}
+
 int main(void) {
     printf("\n");
     demo_allocator_linear();
+    demo_allocator_linear_growable();
     demo_allocator_stack();
     demo_allocator_pool();
+    demo_allocator_free_list();
     return 0;
 }
\ No newline at end of file